@@ -0,0 +1,117 @@
+#ifndef BENCH_DATA_H
+#define BENCH_DATA_H
+
+#include "Student.h"
+#include <cstddef>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Shared helpers for the programs in bench/. Not part of the application build.
+namespace RCBench
+{
+
+    /// Shape of a synthetic data set; the defaults are what the older benches have always used.
+    struct DataSpec
+    {
+        std::size_t rows = 1000;
+        std::size_t classes = 40;
+        std::size_t subjects = 5;
+        std::size_t commentLength = 33; // characters; 0 leaves the comment empty
+        std::size_t quoteEvery = 8;      // every n-th name needs CSV quoting; 0 for none
+        unsigned seed = 42;
+    };
+
+    /// Teacher comment of exactly `length` characters, built from a fixed word list.
+    inline std::string makeComment(std::size_t length)
+    {
+        static const char *const words[] = {"Consistent", "effort", "across", "the", "term,",
+                                            "strong", "in", "practical", "work;", "should",
+                                            "revise", "\"core\"", "topics", "before", "exams."};
+        std::string out;
+        for (std::size_t w = 0; out.size() < length; ++w)
+        {
+            if (!out.empty())
+                out += ' ';
+            out += words[w % (sizeof words / sizeof words[0])];
+        }
+        out.resize(length);
+        return out;
+    }
+
+    /**
+     * @brief Build a deterministic synthetic student list.
+     *
+     * Approach:
+     *   Fixed-seed generator, so the same spec always yields the same records. Quoted names
+     *   alternate between an embedded comma and embedded double quotes; longer comments
+     *   contain commas and quotes too.
+     */
+    inline std::vector<ReportCard::Student> makeStudents(const DataSpec &spec)
+    {
+        std::mt19937 rng(spec.seed);
+        std::uniform_int_distribution<int> mark(0, 100);
+        const std::string comment = makeComment(spec.commentLength);
+        const std::size_t classes = spec.classes ? spec.classes : 1;
+        std::vector<ReportCard::Student> out;
+        out.reserve(spec.rows);
+        for (std::size_t i = 0; i < spec.rows; ++i)
+        {
+            std::vector<int> marks(spec.subjects);
+            for (int &m : marks)
+                m = mark(rng);
+            std::string name;
+            if (spec.quoteEvery == 0 || i % spec.quoteEvery != 0)
+                name = "Student " + std::to_string(i);
+            else if ((i / spec.quoteEvery) % 2 == 0)
+                name = "Lastname, First " + std::to_string(i);
+            else
+                name = "First \"Nick\" Lastname " + std::to_string(i);
+            ReportCard::Student s(name, "Class-" + std::to_string(i % classes), static_cast<int>(i + 1), marks);
+            s.setTeacherComment(comment);
+            out.push_back(s);
+        }
+        return out;
+    }
+
+    inline std::vector<ReportCard::Student> makeStudents(std::size_t rows, unsigned seed = 42)
+    {
+        DataSpec spec;
+        spec.rows = rows;
+        spec.seed = seed;
+        return makeStudents(spec);
+    }
+
+    /// Write makeStudents(spec) to path in the application's CSV format.
+    inline bool writeSyntheticCsv(const std::string &path, const DataSpec &spec)
+    {
+        std::ofstream ofs(path, std::ios::trunc);
+        if (!ofs.is_open())
+            return false;
+        std::string buf;
+        for (const auto &s : makeStudents(spec))
+        {
+            s.appendCSV(buf);
+            buf.push_back('\n');
+            if (buf.size() >= (1u << 20))
+            {
+                ofs.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+                buf.clear();
+            }
+        }
+        ofs.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        return static_cast<bool>(ofs);
+    }
+
+    inline bool writeSyntheticCsv(const std::string &path, std::size_t rows, unsigned seed = 42)
+    {
+        DataSpec spec;
+        spec.rows = rows;
+        spec.seed = seed;
+        return writeSyntheticCsv(path, spec);
+    }
+
+} // namespace RCBench
+
+#endif // BENCH_DATA_H
@@ -0,0 +1,90 @@
+// Compares StudentManager::loadFromFile with heap-allocated records against arena storage
+// (setArenaStorage): load time, reload time and peak resident memory.
+//
+// Each mode runs in its own forked process, because peak RSS (VmHWM) never goes down within
+// a process and the first mode would otherwise inflate the second's figure.
+//
+// Build: g++ -std=c++17 -O2 -pthread bench/arena_load_bench.cpp src/*.cpp -I include -o arena_load_bench
+// Usage: ./arena_load_bench [rows] [path] [threads]
+
+#include "BenchData.h"
+#include "StudentManager.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace ReportCard;
+
+// Peak resident set size of this process in KiB (VmHWM from /proc/self/status), 0 if unknown.
+static long peakRssKiB()
+{
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return stol(line.substr(6));
+    }
+    return 0;
+}
+
+static double secondsSince(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+static void runMode(const char *label, bool arena, const string &path, unsigned threads)
+{
+    long before = peakRssKiB();
+
+    auto t0 = chrono::steady_clock::now();
+    StudentManager mgr(path, threads, arena);
+    double load = secondsSince(t0);
+
+    t0 = chrono::steady_clock::now();
+    mgr.loadFromFile(); // frees the previous records, then loads again
+    double reload = secondsSince(t0);
+
+    long peak = peakRssKiB();
+    printf("%-8s %9zu rows  load %7.3f s  reload %7.3f s  peak RSS %8.1f MB (+%.1f MB)\n", label,
+           mgr.getAll().size(), load, reload, peak / 1024.0, (peak - before) / 1024.0);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = argc > 1 ? stoul(argv[1]) : 1000000;
+    string path = argc > 2 ? argv[2] : "bench_students.csv";
+    unsigned threads = argc > 3 ? static_cast<unsigned>(stoul(argv[3])) : 1;
+
+    if (!RCBench::writeSyntheticCsv(path, rows))
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+
+    const struct
+    {
+        const char *label;
+        bool arena;
+    } modes[] = {{"heap", false}, {"arena", true}};
+    for (const auto &mode : modes)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            runMode(mode.label, mode.arena, path, threads);
+            _exit(0);
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || status != 0)
+            cerr << mode.label << " run failed\n";
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Stress test for ConcurrentStudentManager: read throughput at 1, 2, 4, ... reader threads
+// while one writer keeps editing marks.
+//
+// Readers mix findByRoll, getTopper and getClassSummary and check every result they copy
+// out (right roll, computed fields consistent with the marks), so torn reads would be counted.
+//
+// Build: g++ -std=c++17 -O2 -pthread bench/concurrent_read_bench.cpp src/*.cpp -I include -o concurrent_read_bench
+// Usage: ./concurrent_read_bench [rows] [seconds-per-step] [max-threads]
+
+#include "BenchData.h"
+#include "ConcurrentStudentManager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace std;
+using namespace ReportCard;
+
+// A copied-out student whose computed fields do not match its marks was read mid-write.
+static bool consistent(const Student &s)
+{
+    Student check = s;
+    check.recalculate();
+    return check.getTotal() == s.getTotal() && check.getPercentage() == s.getPercentage();
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = argc > 1 ? stoul(argv[1]) : 100000;
+    double seconds = argc > 2 ? stod(argv[2]) : 1.0;
+    unsigned maxThreads = argc > 3 ? static_cast<unsigned>(stoul(argv[3]))
+                                   : max(8u, thread::hardware_concurrency());
+    string path = "bench_concurrent.csv";
+
+    if (!RCBench::writeSyntheticCsv(path, rows))
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    ConcurrentStudentManager mgr(path);
+    mgr.setJournaling(true); // writer edits append to the journal instead of rewriting the CSV
+    printf("%zu rows, %u hardware threads\n", mgr.size(), thread::hardware_concurrency());
+
+    double baseline = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        atomic<bool> stop{false};
+        atomic<size_t> reads{0}, writes{0}, bad{0};
+
+        thread writer([&]
+                      {
+            mt19937 rng(1);
+            while (!stop.load(memory_order_relaxed))
+            {
+                int roll = 1 + static_cast<int>(rng() % rows);
+                mgr.editMark(roll, rng() % 5, static_cast<int>(rng() % 101));
+                writes.fetch_add(1, memory_order_relaxed);
+                this_thread::sleep_for(chrono::microseconds(200));
+            } });
+
+        vector<thread> readers;
+        for (unsigned t = 0; t < threads; ++t)
+            readers.emplace_back([&, t]
+                                 {
+                mt19937 rng(100 + t);
+                size_t n = 0, wrong = 0;
+                while (!stop.load(memory_order_relaxed))
+                {
+                    int roll = 1 + static_cast<int>(rng() % rows);
+                    switch (n % 8)
+                    {
+                    case 0:
+                        if (auto top = mgr.getTopper())
+                            wrong += !consistent(*top);
+                        break;
+                    case 1:
+                        wrong += mgr.getClassSummary("Class-" + to_string(roll % 40)).count == 0;
+                        break;
+                    default:
+                        if (auto s = mgr.findByRoll(roll))
+                            wrong += s->getRoll() != roll || !consistent(*s);
+                        else
+                            ++wrong;
+                    }
+                    ++n;
+                }
+                reads.fetch_add(n);
+                bad.fetch_add(wrong); });
+
+        this_thread::sleep_for(chrono::duration<double>(seconds));
+        stop = true;
+        for (auto &r : readers)
+            r.join();
+        writer.join();
+
+        double perSecond = reads / seconds;
+        if (threads == 1)
+            baseline = perSecond;
+        printf("%2u readers: %12.0f reads/s  %6.2fx  (%zu writes, %zu bad reads)\n", threads, perSecond,
+               perSecond / baseline, writes.load(), bad.load());
+    }
+
+    mgr.checkpoint();
+    std::remove(path.c_str());
+    std::remove((path + ".journal").c_str());
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Compares the memory-mapped loader in StudentManager::loadFromFile against the
+// original getline + vector<string> + stringstream parser.
+//
+// Build: g++ -std=c++17 -O2 -pthread bench/csv_load_bench.cpp src/*.cpp -I include -o csv_load_bench
+// Usage: ./csv_load_bench [rows] [path] [threads]
+
+#include "BenchData.h"
+#include "StudentManager.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace ReportCard;
+
+// --- The pre-mmap loading path, kept verbatim as the baseline ---
+static string legacyUnescape(const string &s)
+{
+    if (s.size() >= 2 && s.front() == '"' && s.back() == '"')
+    {
+        string inner = s.substr(1, s.size() - 2);
+        string out;
+        for (size_t i = 0; i < inner.size(); ++i)
+        {
+            if (inner[i] == '"' && i + 1 < inner.size() && inner[i + 1] == '"')
+            {
+                out.push_back('"');
+                ++i;
+            }
+            else
+            {
+                out.push_back(inner[i]);
+            }
+        }
+        return out;
+    }
+    return s;
+}
+
+static bool legacyFromCSV(const string &line, Student &outStudent)
+{
+    vector<string> fields;
+    string cur;
+    bool inQuotes = false;
+    for (char c : line)
+    {
+        if (c == '"')
+        {
+            inQuotes = !inQuotes;
+            cur.push_back(c);
+        }
+        else if (c == ',' && !inQuotes)
+        {
+            fields.push_back(cur);
+            cur.clear();
+        }
+        else
+        {
+            cur.push_back(c);
+        }
+    }
+    fields.push_back(cur);
+    if (fields.size() < 9)
+        return false;
+
+    string name = legacyUnescape(fields[0]);
+    string className = legacyUnescape(fields[1]);
+    int roll = stoi(fields[2]);
+    string marksField = legacyUnescape(fields[3]);
+    vector<int> marks;
+    if (!marksField.empty())
+    {
+        stringstream sm(marksField);
+        string token;
+        while (getline(sm, token, ';'))
+        {
+            try
+            {
+                marks.push_back(stoi(token));
+            }
+            catch (...)
+            {
+                marks.push_back(0);
+            }
+        }
+    }
+    Student s(name, className, roll, marks);
+    s.recalculate();
+    s.setTeacherComment(legacyUnescape(fields[8]));
+    outStudent = s;
+    return true;
+}
+
+static size_t legacyLoad(const string &path)
+{
+    vector<Student> students;
+    ifstream ifs(path);
+    string line;
+    while (getline(ifs, line))
+    {
+        if (line.empty())
+            continue;
+        Student s;
+        if (legacyFromCSV(line, s))
+            students.push_back(s);
+    }
+    return students.size();
+}
+
+template <typename Fn>
+static double bestSeconds(Fn fn, int runs = 3)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto t0 = chrono::steady_clock::now();
+        fn();
+        auto t1 = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+static void report(const char *label, double seconds, size_t rows, uintmax_t bytes)
+{
+    printf("%-28s %8.3f s %10.1f MB/s %12.0f rows/s\n", label, seconds,
+           bytes / seconds / (1024.0 * 1024.0), rows / seconds);
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = argc > 1 ? stoul(argv[1]) : 200000;
+    string path = argc > 2 ? argv[2] : "bench_students.csv";
+
+    if (!RCBench::writeSyntheticCsv(path, rows))
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    uintmax_t bytes = filesystem::file_size(path);
+
+    size_t loaded = 0;
+    double legacy = bestSeconds([&]
+                                { loaded = legacyLoad(path); });
+    report("getline + stringstream", legacy, loaded, bytes);
+
+    StudentManager mgr(path);
+    double mapped = bestSeconds([&]
+                                { mgr.loadFromFile(); });
+    report("mmap + string_view", mapped, mgr.getAll().size(), bytes);
+
+    printf("speedup: %.2fx\n", legacy / mapped);
+
+    unsigned threads = argc > 3 ? static_cast<unsigned>(stoul(argv[3])) : 0;
+    mgr.setLoadThreads(threads);
+    double parallel = bestSeconds([&]
+                                  { mgr.loadFromFile(); });
+    report("mmap + parallel parse", parallel, mgr.getAll().size(), bytes);
+    std::remove(path.c_str());
+    return 0;
+}
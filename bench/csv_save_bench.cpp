@@ -0,0 +1,122 @@
+// Compares CSV serialization through the original ostringstream-based toCSV() with the
+// buffer-appending Student::appendCSV() path used by saveToFile().
+//
+// Build: g++ -std=c++17 -O2 -pthread bench/csv_save_bench.cpp src/*.cpp -I include -o csv_save_bench
+// Usage: ./csv_save_bench [rows] [path]
+
+#include "BenchData.h"
+#include "StudentManager.h"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace ReportCard;
+
+// --- The pre-buffer serialization path, kept as the baseline ---
+static string legacyEscape(string_view s)
+{
+    if (s.find(',') != string::npos || s.find('"') != string::npos)
+    {
+        string out = "\"";
+        for (char c : s)
+        {
+            if (c == '"')
+                out += "\"\"";
+            else
+                out += c;
+        }
+        out += "\"";
+        return out;
+    }
+    return string(s);
+}
+
+static string legacyToCSV(const Student &s)
+{
+    ostringstream oss;
+    oss << legacyEscape(s.getName()) << "," << legacyEscape(s.getClassName()) << "," << s.getRoll() << ",\"";
+    MarkSpan marks = s.getMarks();
+    for (size_t i = 0; i < marks.size(); ++i)
+    {
+        if (i)
+            oss << ";";
+        oss << marks[i];
+    }
+    oss << "\"," << s.getTotal() << "," << fixed << setprecision(2) << s.getPercentage() << ","
+        << s.getGrade() << "," << (s.isPass() ? "1" : "0");
+    oss << "," << legacyEscape(s.getTeacherComment());
+    return oss.str();
+}
+
+template <typename Fn>
+static double bestSeconds(Fn fn, int runs = 3)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto t0 = chrono::steady_clock::now();
+        fn();
+        auto t1 = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = argc > 1 ? stoul(argv[1]) : 200000;
+    string path = argc > 2 ? argv[2] : "bench_save.csv";
+
+    if (!RCBench::writeSyntheticCsv(path, rows))
+    {
+        cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    StudentManager mgr(path);
+    const vector<Student> &students = mgr.getAll();
+
+    // serialization only (no disk)
+    size_t bytes = 0;
+    double tLegacy = bestSeconds([&]
+                                 {
+        bytes = 0;
+        for (const auto &s : students)
+            bytes += legacyToCSV(s).size() + 1; });
+    string buf;
+    double tAppend = bestSeconds([&]
+                                 {
+        buf.clear();
+        for (const auto &s : students)
+        {
+            s.appendCSV(buf);
+            buf.push_back('\n');
+        } });
+
+    // end to end: legacy ofstream << toCSV() << "\n" versus saveToFile()
+    string legacyPath = path + ".legacy";
+    double tLegacyFile = bestSeconds([&]
+                                     {
+        ofstream ofs(legacyPath, ios::trunc);
+        for (const auto &s : students)
+            ofs << legacyToCSV(s) << "\n"; });
+    double tSave = bestSeconds([&]
+                               { mgr.saveToFile(); });
+
+    string legacyAll;
+    legacyAll.reserve(bytes);
+    for (const auto &s : students)
+        legacyAll += legacyToCSV(s) + "\n";
+    bool same = buf == legacyAll;
+    printf("rows=%zu bytes=%zu output-identical=%s\n", students.size(), bytes, same ? "yes" : "NO");
+    printf("%-30s %8.3f s %12.0f rows/s\n", "legacy toCSV (ostringstream)", tLegacy, students.size() / tLegacy);
+    printf("%-30s %8.3f s %12.0f rows/s\n", "appendCSV into buffer", tAppend, students.size() / tAppend);
+    printf("%-30s %8.3f s %12.0f rows/s\n", "legacy ofstream save", tLegacyFile, students.size() / tLegacyFile);
+    printf("%-30s %8.3f s %12.0f rows/s\n", "saveToFile", tSave, students.size() / tSave);
+
+    std::remove(legacyPath.c_str());
+    std::remove(path.c_str());
+    return same ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// Lookup latency through DiskIndex as the data file grows: random findByRoll and
+// find(class, roll) probes plus one class scan, at 10k, 1M and 10M rows by default.
+// Latency should grow with log(rows), not rows; the first probes of each size run against a
+// cold page cache for the index only as far as the OS has evicted it.
+//
+// Build: g++ -std=c++17 -O2 -pthread bench/disk_index_bench.cpp src/*.cpp -I include -o disk_index_bench
+// Usage: ./disk_index_bench [probes] [rows...]
+
+#include "BenchData.h"
+#include "DiskIndex.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ReportCard;
+
+static double secondsSince(chrono::steady_clock::time_point t0)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+    size_t probes = argc > 1 ? stoul(argv[1]) : 100000;
+    vector<size_t> sizes;
+    for (int i = 2; i < argc; ++i)
+        sizes.push_back(stoul(argv[i]));
+    if (sizes.empty())
+        sizes = {10000, 1000000, 10000000};
+    const string path = "bench_index.csv";
+
+    for (size_t rows : sizes)
+    {
+        RCBench::DataSpec spec;
+        spec.rows = rows;
+        spec.commentLength = 0; // keep the 10M-row file small enough for a quick run
+        if (!RCBench::writeSyntheticCsv(path, spec))
+        {
+            cerr << "cannot write " << path << "\n";
+            return 1;
+        }
+
+        auto t0 = chrono::steady_clock::now();
+        if (!DiskIndex::build(path))
+        {
+            cerr << "cannot index " << path << "\n";
+            return 1;
+        }
+        double build = secondsSince(t0);
+
+        DiskIndex index(path);
+        mt19937 rng(7);
+        Student s;
+        size_t hits = 0;
+        t0 = chrono::steady_clock::now();
+        for (size_t i = 0; i < probes; ++i)
+            hits += index.findByRoll(1 + static_cast<int>(rng() % rows), s);
+        double byRoll = secondsSince(t0);
+
+        t0 = chrono::steady_clock::now();
+        for (size_t i = 0; i < probes; ++i)
+        {
+            size_t r = rng() % rows;
+            // makeStudents puts row r (roll r + 1) in class r % classes
+            hits += index.find("Class-" + to_string(r % spec.classes), static_cast<int>(r + 1), s);
+        }
+        double byKey = secondsSince(t0);
+
+        t0 = chrono::steady_clock::now();
+        size_t members = index.scanClass("Class-7", [](const Student &) { return true; });
+        double scan = secondsSince(t0);
+
+        printf("%9zu rows  build %7.2f s  findByRoll %7.2f us  find(class,roll) %7.2f us  "
+               "scanClass %zu rows %.3f s  (%zu/%zu hits)\n",
+               rows, build, 1e6 * byRoll / probes, 1e6 * byKey / probes, members, scan, hits, 2 * probes);
+        fflush(stdout);
+    }
+    std::remove(path.c_str());
+    std::remove(DiskIndex::pathFor(path).c_str());
+    return 0;
+}
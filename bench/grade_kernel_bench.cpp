@@ -0,0 +1,98 @@
+// Measures the batch grading kernel against per-student Student::recalculate() and checks
+// that all three paths agree bit for bit.
+//
+// Build: g++ -std=c++17 -O2 bench/grade_kernel_bench.cpp src/*.cpp -I include -o grade_kernel_bench
+// Usage: ./grade_kernel_bench [rows] [subjects]
+
+#include "GradeKernel.h"
+#include "Student.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ReportCard;
+
+template <typename Fn>
+static double bestSeconds(Fn fn, int runs = 5)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto t0 = chrono::steady_clock::now();
+        fn();
+        auto t1 = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+struct Results
+{
+    vector<int> totals;
+    vector<double> percentages;
+    vector<Grade> grades;
+    vector<uint8_t> pass;
+    explicit Results(size_t n) : totals(n), percentages(n), grades(n), pass(n) {}
+};
+
+static bool sameBits(const Results &a, const Results &b)
+{
+    return a.totals == b.totals && a.grades == b.grades && a.pass == b.pass &&
+           memcmp(a.percentages.data(), b.percentages.data(), a.percentages.size() * sizeof(double)) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = argc > 1 ? stoul(argv[1]) : 1000000;
+    size_t subjects = argc > 2 ? stoul(argv[2]) : 5;
+
+    mt19937 rng(7);
+    uniform_int_distribution<int> mark(0, 100);
+    vector<int> marks(rows * subjects);
+    for (int &m : marks)
+        m = mark(rng);
+    vector<size_t> offsets(rows + 1);
+    for (size_t r = 0; r <= rows; ++r)
+        offsets[r] = r * subjects;
+
+    vector<Student> students;
+    students.reserve(rows);
+    for (size_t r = 0; r < rows; ++r)
+        students.emplace_back("s", "c", static_cast<int>(r),
+                              vector<int>(marks.begin() + offsets[r], marks.begin() + offsets[r + 1]));
+
+    Results viaRecalc(rows), scalar(rows), simd(rows);
+    double tRecalc = bestSeconds([&]
+                                 {
+        for (auto &s : students)
+            s.recalculate(); });
+    for (size_t r = 0; r < rows; ++r)
+    {
+        const Student &s = students[r];
+        viaRecalc.totals[r] = s.getTotal();
+        viaRecalc.percentages[r] = s.getPercentage();
+        viaRecalc.grades[r] = s.getGradeCode();
+        viaRecalc.pass[r] = s.isPass();
+    }
+
+    double tScalar = bestSeconds([&]
+                                 { gradeRowsScalar(marks.data(), offsets.data(), rows, scalar.totals.data(),
+                                                   scalar.percentages.data(), scalar.grades.data(), scalar.pass.data()); });
+    double tSimd = bestSeconds([&]
+                               { gradeRows(marks.data(), offsets.data(), rows, simd.totals.data(),
+                                           simd.percentages.data(), simd.grades.data(), simd.pass.data()); });
+
+    printf("rows=%zu subjects=%zu simd=%s\n", rows, subjects, gradeKernelUsesSimd() ? "avx2" : "none");
+    printf("%-26s %9.4f s %12.0f rows/s\n", "Student::recalculate", tRecalc, rows / tRecalc);
+    printf("%-26s %9.4f s %12.0f rows/s\n", "gradeRowsScalar", tScalar, rows / tScalar);
+    printf("%-26s %9.4f s %12.0f rows/s\n", "gradeRows", tSimd, rows / tSimd);
+    printf("speedup vs recalculate: %.2fx, vs scalar batch: %.2fx\n", tRecalc / tSimd, tScalar / tSimd);
+
+    bool identical = sameBits(viaRecalc, scalar) && sameBits(viaRecalc, simd);
+    printf("bit-identical: %s\n", identical ? "yes" : "NO");
+    return identical ? 0 : 1;
+}
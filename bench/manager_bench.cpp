@@ -0,0 +1,216 @@
+// Benchmark suite for StudentManager and Student: times the everyday operations at several
+// data-set sizes and prints the results as JSON, so runs can be diffed to catch regressions.
+//
+// Each operation is repeated until it has run for roughly --min-time seconds (at least once)
+// and reported per operation. Progress goes to stderr, JSON to stdout (or --out).
+//
+// Build: g++ -std=c++17 -O2 -pthread bench/manager_bench.cpp src/*.cpp -I include -o manager_bench
+// Usage: ./manager_bench [--sizes 1000,100000,1000000] [--classes M] [--subjects K]
+//                        [--comment-length L] [--seed S] [--min-time SECONDS] [--out FILE]
+
+#include "BenchData.h"
+#include "StudentManager.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ReportCard;
+
+struct Result
+{
+    size_t rows;
+    string op;
+    size_t iterations; // calls of the operation
+    double seconds;    // total time spent in those calls
+};
+
+// Keeps results observable so the optimiser cannot drop the measured calls.
+static volatile size_t sink;
+
+/**
+ * Run fn repeatedly until minTime has elapsed; setup (untimed) runs before every call.
+ * fn returns how many operations the call performed.
+ */
+static Result measure(size_t rows, const string &op, double minTime, const function<void()> &setup,
+                      const function<size_t()> &fn)
+{
+    Result r{rows, op, 0, 0.0};
+    do
+    {
+        if (setup)
+            setup();
+        auto t0 = chrono::steady_clock::now();
+        r.iterations += fn();
+        r.seconds += chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    } while (r.seconds < minTime);
+    cerr << "  " << op << ": " << r.iterations << " ops in " << r.seconds << " s\n";
+    return r;
+}
+
+static void runSize(const RCBench::DataSpec &spec, double minTime, vector<Result> &out)
+{
+    const string path = "bench_manager.csv";
+    cerr << spec.rows << " rows\n";
+    if (!RCBench::writeSyntheticCsv(path, spec))
+    {
+        cerr << "cannot write " << path << "\n";
+        return;
+    }
+
+    string pristine;
+    {
+        ifstream ifs(path);
+        pristine.assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+    }
+
+    StudentManager mgr(path);
+    mgr.setJournaling(true); // time the operation itself, not a full CSV rewrite per call
+    const size_t rows = spec.rows;
+    const size_t probes = 100000; // lookups per timed call
+    mt19937 rng(spec.seed);
+
+    out.push_back(measure(rows, "loadFromFile", minTime, nullptr, [&]
+                          { mgr.loadFromFile(); return size_t(1); }));
+    out.push_back(measure(rows, "saveToFile", minTime, nullptr, [&]
+                          { mgr.saveToFile(); return size_t(1); }));
+
+    vector<int> rolls(probes);
+    for (int &roll : rolls)
+        roll = 1 + static_cast<int>(rng() % (rows ? rows : 1));
+    out.push_back(measure(rows, "findByRoll", minTime, nullptr, [&]
+                          {
+        const StudentManager &view = mgr;
+        size_t hits = 0;
+        for (int roll : rolls)
+            hits += view.findByRoll(roll) != nullptr;
+        sink = hits;
+        return probes; }));
+
+    const size_t classes = spec.classes ? spec.classes : 1;
+    out.push_back(measure(rows, "getStudentsByClass", minTime, nullptr, [&]
+                          {
+        size_t found = 0;
+        for (size_t c = 0; c < classes; ++c)
+            found += mgr.getStudentsByClass("Class-" + to_string(c)).size();
+        sink = found;
+        return classes; }));
+
+    out.push_back(measure(rows, "getTopper", minTime, nullptr, [&]
+                          {
+        size_t n = 0;
+        for (size_t i = 0; i < probes; ++i)
+            n += mgr.getTopper() != nullptr;
+        sink = n;
+        return probes; }));
+
+    // every call sorts the generated order again, not an already sorted list: put the
+    // original CSV back (and drop the journaled sorts) before each call
+    out.push_back(measure(rows, "sortByPercentageDesc", minTime, [&]
+                          {
+        ofstream(path, ios::trunc) << pristine;
+        std::remove((path + ".journal").c_str());
+        mgr.loadFromFile(); }, [&]
+                          { mgr.sortByPercentageDesc(); return size_t(1); }));
+
+    out.push_back(measure(rows, "toCSV", minTime, nullptr, [&]
+                          {
+        size_t bytes = 0;
+        for (const auto &s : mgr.getAll())
+            bytes += s.toCSV().size();
+        sink = bytes;
+        return mgr.getAll().size(); }));
+
+    out.push_back(measure(rows, "formattedReportCard", minTime, nullptr, [&]
+                          {
+        size_t bytes = 0;
+        for (const auto &s : mgr.getAll())
+            bytes += s.formattedReportCard().size();
+        sink = bytes;
+        return mgr.getAll().size(); }));
+
+    mgr.checkpoint();
+    std::remove(path.c_str());
+    std::remove((path + ".journal").c_str());
+}
+
+static string toJson(const RCBench::DataSpec &spec, double minTime, const vector<Result> &results)
+{
+    ostringstream os;
+    os.precision(9);
+    os << "{\n  \"benchmark\": \"manager_bench\",\n"
+       << "  \"config\": {\"classes\": " << spec.classes << ", \"subjects\": " << spec.subjects
+       << ", \"commentLength\": " << spec.commentLength << ", \"quoteEvery\": " << spec.quoteEvery
+       << ", \"seed\": " << spec.seed << ", \"minTime\": " << minTime << "},\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &r = results[i];
+        double perOp = r.iterations ? r.seconds / static_cast<double>(r.iterations) : 0.0;
+        os << (i ? ",\n" : "\n") << "    {\"rows\": " << r.rows << ", \"op\": \"" << r.op
+           << "\", \"iterations\": " << r.iterations << ", \"seconds\": " << r.seconds
+           << ", \"nsPerOp\": " << perOp * 1e9 << ", \"opsPerSecond\": " << (perOp > 0 ? 1.0 / perOp : 0.0)
+           << "}";
+    }
+    os << "\n  ]\n}\n";
+    return os.str();
+}
+
+int main(int argc, char **argv)
+{
+    vector<size_t> sizes{1000, 100000, 1000000};
+    RCBench::DataSpec spec;
+    double minTime = 0.5;
+    string outPath;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        string flag = argv[i], value = argv[i + 1];
+        if (flag == "--sizes")
+        {
+            sizes.clear();
+            stringstream list(value);
+            for (string item; getline(list, item, ',');)
+                sizes.push_back(stoul(item));
+        }
+        else if (flag == "--classes")
+            spec.classes = stoul(value);
+        else if (flag == "--subjects")
+            spec.subjects = stoul(value);
+        else if (flag == "--comment-length")
+            spec.commentLength = stoul(value);
+        else if (flag == "--seed")
+            spec.seed = static_cast<unsigned>(stoul(value));
+        else if (flag == "--min-time")
+            minTime = stod(value);
+        else if (flag == "--out")
+            outPath = value;
+        else
+        {
+            cerr << "unknown option " << flag << "\n";
+            return 2;
+        }
+    }
+
+    vector<Result> results;
+    for (size_t rows : sizes)
+    {
+        spec.rows = rows;
+        runSize(spec, minTime, results);
+    }
+
+    string json = toJson(spec, minTime, results);
+    if (outPath.empty())
+    {
+        cout << json;
+        return 0;
+    }
+    ofstream ofs(outPath, ios::trunc);
+    ofs << json;
+    return ofs ? 0 : 1;
+}
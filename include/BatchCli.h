@@ -0,0 +1,50 @@
+#ifndef BATCH_CLI_H
+#define BATCH_CLI_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ReportCard
+{
+
+    /**
+     * Objective:
+     *  Run one non-interactive command (for cron jobs and scripts) and return an exit code.
+     *
+     * Input:
+     *  @param args std::vector<std::string> - command-line arguments after the program name
+     *  @param defaultDataFile std::string - CSV used unless --data FILE is given
+     *  @param out std::ostream& - normal output
+     *  @param err std::ostream& - diagnostics and usage
+     *
+     * Output: 0 on success, 1 if the command failed, 2 on a usage error
+     * Approach:
+     *  Global options (--data, --threads, --metrics) are read first; the StudentManager is
+     *  then loaded once and the command runs without prompts. Commands:
+     *    import FILE                 add every student in another CSV as one batch
+     *    export DIR [--max-open N]   one report card file per student
+     *    query --class NAME | --roll N
+     *    topk K [--class NAME]
+     *    rank [K]                    StudentManager::ranking(): competition and dense ranks
+     *    regrade                     recompute results from marks and save
+     *    stats                       Metrics::toText() for this run (--metrics FILE also
+     *                                writes Prometheus text when the run ends)
+     *    scan [filters] [--by-class] [--list]
+     *                                StudentCursor pass over the file, no load (filters:
+     *                                --class NAME, --passed/--failed, --min P, --max P)
+     *    index                       DiskIndex::build() for the data file
+     *    lookup --roll N | --class NAME [--roll N]
+     *                                report cards through the DiskIndex, no load
+     *    run FILE                    commands from a file, one per line; mutations
+     *                                (add/marks/comment/remove) are committed as one batch
+     *
+     * Side Effects:
+     *  - Reads/writes the data file and any files named by the command; writes to out/err.
+     */
+    int runBatchCli(const std::vector<std::string> &args, const std::string &defaultDataFile,
+                    std::ostream &out, std::ostream &err);
+
+} // namespace ReportCard
+
+#endif // BATCH_CLI_H
@@ -0,0 +1,171 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace ReportCard
+{
+
+    // --- Little-endian encoders used by the binary snapshot format ---
+    // Values are written byte by byte so snapshots are portable across hosts.
+
+    inline void putU8(std::string &out, std::uint8_t v)
+    {
+        out.push_back(static_cast<char>(v));
+    }
+
+    inline void putU32(std::string &out, std::uint32_t v)
+    {
+        char b[4];
+        for (int i = 0; i < 4; ++i)
+            b[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+        out.append(b, 4);
+    }
+
+    inline void putU64(std::string &out, std::uint64_t v)
+    {
+        char b[8];
+        for (int i = 0; i < 8; ++i)
+            b[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+        out.append(b, 8);
+    }
+
+    inline void putI32(std::string &out, std::int32_t v)
+    {
+        putU32(out, static_cast<std::uint32_t>(v));
+    }
+
+    inline void putF64(std::string &out, double v)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        putU64(out, bits);
+    }
+
+    /// Length-prefixed (u32) string.
+    inline void putString(std::string &out, std::string_view s)
+    {
+        putU32(out, static_cast<std::uint32_t>(s.size()));
+        out.append(s.data(), s.size());
+    }
+
+    /**
+     * @class BinaryReader
+     * @brief Bounds-checked little-endian cursor over a byte range.
+     *
+     * Every getter returns false (and leaves the cursor unusable) once the input runs out,
+     * so callers can read a whole record and check once.
+     */
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const char *begin, const char *end) : cur_(begin), end_(end) {}
+
+        bool getU8(std::uint8_t &v)
+        {
+            if (!need(1))
+                return false;
+            v = static_cast<std::uint8_t>(*cur_++);
+            return true;
+        }
+
+        bool getU32(std::uint32_t &v)
+        {
+            if (!need(4))
+                return false;
+            v = 0;
+            for (int i = 0; i < 4; ++i)
+                v |= static_cast<std::uint32_t>(static_cast<unsigned char>(cur_[i])) << (8 * i);
+            cur_ += 4;
+            return true;
+        }
+
+        bool getU64(std::uint64_t &v)
+        {
+            if (!need(8))
+                return false;
+            v = 0;
+            for (int i = 0; i < 8; ++i)
+                v |= static_cast<std::uint64_t>(static_cast<unsigned char>(cur_[i])) << (8 * i);
+            cur_ += 8;
+            return true;
+        }
+
+        bool getI32(std::int32_t &v)
+        {
+            std::uint32_t u;
+            if (!getU32(u))
+                return false;
+            v = static_cast<std::int32_t>(u);
+            return true;
+        }
+
+        bool getF64(double &v)
+        {
+            std::uint64_t bits;
+            if (!getU64(bits))
+                return false;
+            std::memcpy(&v, &bits, sizeof v);
+            return true;
+        }
+
+        template <typename String> // std::string or std::pmr::string
+        bool getString(String &s)
+        {
+            std::uint32_t len;
+            if (!getU32(len) || !need(len))
+                return false;
+            s.assign(cur_, len);
+            cur_ += len;
+            return true;
+        }
+
+        const char *position() const { return cur_; }
+        bool atEnd() const { return cur_ == end_; }
+
+    private:
+        bool need(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_ - cur_) < n)
+            {
+                cur_ = end_;
+                return false;
+            }
+            return true;
+        }
+
+        const char *cur_;
+        const char *end_;
+    };
+
+    /**
+     * Objective:
+     *  Checksum a byte range for snapshot integrity checks.
+     *
+     * Approach: FNV-1a style mixing over 64-bit little-endian words, then the trailing bytes.
+     *  Word-at-a-time keeps verification far cheaper than reading the file.
+     */
+    inline std::uint64_t checksum64(const char *data, std::size_t size)
+    {
+        std::uint64_t h = 14695981039346656037ULL;
+        const std::uint64_t prime = 1099511628211ULL;
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t w = 0;
+            for (int b = 0; b < 8; ++b)
+                w |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i + b])) << (8 * b);
+            h = (h ^ w) * prime;
+        }
+        for (; i < size; ++i)
+            h = (h ^ static_cast<unsigned char>(data[i])) * prime;
+        return h;
+    }
+
+} // namespace ReportCard
+
+#endif // BINARY_IO_H
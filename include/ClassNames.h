@@ -0,0 +1,59 @@
+#ifndef CLASS_NAMES_H
+#define CLASS_NAMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ReportCard
+{
+
+    /// One interned class/section name. Entries are never moved or freed, so references to
+    /// them (and to text) stay valid for the life of the program.
+    struct ClassName
+    {
+        std::string text;
+        std::uint32_t id;
+    };
+
+    /**
+     * @class ClassNames
+     * @brief Process-wide intern table for class/section names.
+     *
+     * Every Student with the same class shares one entry and stores only a pointer to it;
+     * StudentManager and StudentTable key their class indexes on the entry's dense id.
+     * All members are thread-safe; lookups of existing names take a shared lock, so concurrent
+     * readers do not serialize on the table.
+     */
+    class ClassNames
+    {
+    public:
+        /**
+         * Objective:
+         *  Get the shared entry for a class name, creating it on first use.
+         *
+         * Input:
+         *  @param name std::string_view - class/section name
+         * Output: reference to the interned entry (ids are assigned 0, 1, 2, ...)
+         * Approach: per-thread cache of the last entry, then a hash lookup under a shared lock;
+         *  the exclusive lock is taken only to add a name not seen before.
+         *
+         * Side Effects:
+         *  - May add an entry to the process-wide table.
+         */
+        static const ClassName &intern(std::string_view name);
+
+        /// Id of an already-interned name; returns false (and interns nothing) if unknown.
+        static bool find(std::string_view name, std::uint32_t &outId);
+
+        /// Entry for an id returned by intern()/find().
+        static const ClassName &byId(std::uint32_t id);
+
+        /// Number of names interned so far (valid ids are 0 .. count() - 1).
+        static std::size_t count();
+    };
+
+} // namespace ReportCard
+
+#endif // CLASS_NAMES_H
@@ -0,0 +1,127 @@
+#ifndef CONCURRENT_STUDENT_MANAGER_H
+#define CONCURRENT_STUDENT_MANAGER_H
+
+#include "StudentManager.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace ReportCard
+{
+
+    /**
+     * @class ConcurrentStudentManager
+     * @brief Thread-safe facade over one StudentManager for multi-threaded embedding.
+     *
+     * Reads take a shared lock and return copies, so a result stays valid however long the
+     * caller keeps it, whatever writers do afterwards. Writes (and anything that touches
+     * disk) take the lock exclusively. withRead()/withWrite() run a callable under the lock
+     * for zero-copy access; references obtained there must not escape the callable.
+     *
+     * std::shared_mutex may keep admitting readers while a writer waits, so writers also
+     * announce themselves: new readers queue behind a waiting writer instead of starving it.
+     */
+    class ConcurrentStudentManager
+    {
+    public:
+        /**
+         * Objective:
+         *  Load the data file into a manager guarded by a reader-writer lock.
+         *
+         * Input:
+         *  @param filename std::string - path to CSV storage file
+         *  @param loadThreads unsigned - parse threads for loading (see StudentManager)
+         * Output: constructed facade
+         * Approach: constructs the wrapped StudentManager (one load).
+         *
+         * Side Effects:
+         *  - Reads the data file.
+         */
+        explicit ConcurrentStudentManager(const std::string &filename, unsigned loadThreads = 1);
+
+        // --- Reads (shared lock; results are copies) ---
+        std::optional<Student> findByRoll(int roll) const;
+        std::vector<Student> getStudentsByClass(const std::string &className) const;
+        std::optional<Student> getTopper() const;
+        std::vector<Student> topK(std::size_t k) const;
+        /// 0 if the roll is unknown (see StudentManager::rankOf).
+        std::size_t rankOf(int roll) const;
+        ClassSummary getClassSummary(const std::string &className) const;
+        ClassSummary getSchoolSummary() const;
+        bool rollExists(int roll) const;
+        std::size_t size() const;
+
+        // --- Writes (exclusive lock; same results as the StudentManager calls) ---
+        bool addStudent(const Student &s);
+        bool editMarks(int roll, const std::vector<int> &newMarks);
+        bool editMark(int roll, std::size_t subject, int mark);
+        bool editTeacherComment(int roll, const std::string &comment);
+        bool removeByRoll(int roll);
+        void sortByPercentageDesc();
+        BatchResult commitBatch(const StudentBatch &batch);
+        bool saveToFile();
+        bool checkpoint();
+        void setJournaling(bool enabled);
+
+        /**
+         * Objective:
+         *  Run a read-only callable against the manager under the shared lock.
+         *
+         * Input:
+         *  @param fn callable taking const StudentManager&
+         * Output: whatever fn returns (return copies, not references into the manager)
+         * Approach: std::shared_lock for the duration of the call.
+         *
+         * Side Effects:
+         *  - Blocks writers while fn runs.
+         */
+        template <typename Fn>
+        auto withRead(Fn fn) const
+        {
+            ReadLock lock(*this);
+            return fn(static_cast<const StudentManager &>(manager_));
+        }
+
+        /// Run a callable with exclusive access (for operations the facade does not wrap).
+        template <typename Fn>
+        auto withWrite(Fn fn)
+        {
+            WriteLock lock(*this);
+            return fn(manager_);
+        }
+
+    private:
+        // Shared lock; waits at the gate first if a writer has announced itself.
+        class ReadLock
+        {
+        public:
+            explicit ReadLock(const ConcurrentStudentManager &owner);
+
+        private:
+            std::shared_lock<std::shared_mutex> lock_;
+        };
+
+        // Exclusive lock; holds the gate from announcement until the write is finished.
+        class WriteLock
+        {
+        public:
+            explicit WriteLock(const ConcurrentStudentManager &owner);
+
+        private:
+            std::lock_guard<std::mutex> gate_;
+            std::unique_lock<std::shared_mutex> lock_;
+        };
+
+        mutable std::shared_mutex mutex_;
+        mutable std::mutex gate_;                        // taken by writers, briefly by readers
+        mutable std::atomic<unsigned> writersWaiting_{0}; // readers check this lock-free
+        StudentManager manager_;
+    };
+
+} // namespace ReportCard
+
+#endif // CONCURRENT_STUDENT_MANAGER_H
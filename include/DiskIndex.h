@@ -0,0 +1,130 @@
+#ifndef DISK_INDEX_H
+#define DISK_INDEX_H
+
+#include "MappedFile.h"
+#include "Student.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ReportCard
+{
+
+    /// Where one record's line sits in the data file (see DiskIndex::write()).
+    struct IndexEntry
+    {
+        std::uint32_t classId; // ClassNames id in write(); class-table ordinal when read back
+        std::int32_t roll;
+        std::uint64_t offset;  // byte offset of the line
+        std::uint32_t length;  // line length without the '\n'
+    };
+
+    /**
+     * @class DiskIndex
+     * @brief Sorted on-disk index of a students CSV, for lookups without loading the file.
+     *
+     * `<data>.idx` holds the sorted class names, one fixed-width entry per record ordered by
+     * (class, roll, offset), and the entry numbers again ordered by (roll, offset). The file
+     * is memory-mapped and binary-searched, so a lookup touches O(log n) index pages and then
+     * reads and parses only the matching line(s). Like the binary snapshot, the index records
+     * the CSV's size and mtime and is ignored once the CSV no longer matches; changes still
+     * in a StudentManager journal are not visible until checkpoint().
+     */
+    class DiskIndex
+    {
+    public:
+        /// Index path for a data file: `<dataFile>.idx`.
+        static std::string pathFor(const std::string &dataFile);
+
+        /**
+         * Objective:
+         *  Write the index of a data file from entries collected while writing the CSV.
+         *
+         * Input:
+         *  @param dataFile std::string - CSV the entries describe (already renamed into place)
+         *  @param entries std::vector<IndexEntry>& - one per line, any order (sorted here)
+         * Output: false on I/O failure, or if the CSV cannot be stat'ed
+         * Approach: sort by (class name, roll, offset), add the roll-ordered section and the
+         *  CSV's current identity, then write through a temporary file.
+         *
+         * Side Effects:
+         *  - Replaces `<dataFile>.idx`; reorders entries.
+         */
+        static bool write(const std::string &dataFile, std::vector<IndexEntry> &entries);
+
+        /**
+         * Objective:
+         *  Build the index of an existing data file without loading it.
+         *
+         * Input:
+         *  @param dataFile std::string - students CSV
+         * Output: false if the CSV cannot be read or the index cannot be written
+         * Approach: one StudentCursor pass collecting line offsets, then write().
+         *
+         * Side Effects:
+         *  - Reads the CSV; replaces `<dataFile>.idx`.
+         */
+        static bool build(const std::string &dataFile);
+
+        /**
+         * Objective:
+         *  Open the index of a data file for lookups.
+         *
+         * Input:
+         *  @param dataFile std::string - students CSV
+         * Output: DiskIndex; isOpen() is false if the index is missing, malformed or stale
+         * Approach: maps the index, checks its header against the CSV's size and mtime and
+         *  reads the (small) class table; entries stay on disk.
+         *
+         * Side Effects:
+         *  - Opens the index and the data file (closed by the destructor).
+         */
+        explicit DiskIndex(const std::string &dataFile);
+
+        bool isOpen() const;
+        std::size_t size() const; // indexed records
+
+        /// First record (in file order) with this roll, in any class.
+        bool findByRoll(int roll, Student &out);
+        /// First record (in file order) with this class and roll.
+        bool find(const std::string &className, int roll, Student &out);
+
+        /**
+         * Objective:
+         *  Visit every record of one class, in roll order.
+         *
+         * Input:
+         *  @param className std::string - class/section name
+         *  @param visit callable - receives each record; return false to stop early
+         * Output: number of records visited
+         * Approach: binary search for the class's contiguous entry range, then read each
+         *  line it points to.
+         *
+         * Side Effects:
+         *  - Reads the data file.
+         */
+        std::size_t scanClass(const std::string &className, const std::function<bool(const Student &)> &visit);
+
+    private:
+        IndexEntry entryAt(std::uint64_t i) const; // i-th entry in (class, roll) order
+        std::uint32_t rollOrderAt(std::uint64_t i) const;
+        bool classOrdinal(const std::string &className, std::uint32_t &ordinal) const;
+        bool readRecord(const IndexEntry &entry, Student &out);
+
+        std::unique_ptr<MappedFile> map_;
+        std::ifstream data_;
+        std::vector<std::string> classes_; // sorted; an entry's classId is an index into this
+        std::uint64_t count_ = 0;
+        const char *entries_ = nullptr;
+        const char *rollOrder_ = nullptr;
+        std::string line_; // reused read buffer
+        bool open_ = false;
+    };
+
+} // namespace ReportCard
+
+#endif // DISK_INDEX_H
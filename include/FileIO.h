@@ -0,0 +1,47 @@
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include <cstdint>
+#include <string>
+
+namespace ReportCard
+{
+
+    // --- File helpers shared by the CSV, journal, snapshot and disk index writers ---
+
+    /**
+     * Objective:
+     *  Read the identity (size and mtime) that snapshots, the journal and the disk index
+     *  record for the CSV they mirror.
+     *
+     * Input:
+     *  @param path std::string - file to inspect
+     *  @param size std::uint64_t& - receives the size in bytes
+     *  @param mtime std::uint64_t& - receives the last write time in filesystem clock ticks
+     * Output: false if the file cannot be inspected (outputs untouched)
+     * Approach: std::filesystem::file_size and last_write_time with error codes.
+     *
+     * Side Effects:
+     *  - None (reads file metadata only).
+     */
+    bool fileIdentity(const std::string &path, std::uint64_t &size, std::uint64_t &mtime);
+
+    /**
+     * Objective:
+     *  Move a finished temporary file over path.
+     *
+     * Input:
+     *  @param tmp std::string - fully written temporary file
+     *  @param path std::string - destination
+     * Output: false if the file could not be moved
+     * Approach: std::rename (atomic on most OSes); if that fails (e.g. the destination
+     *  exists on platforms where rename does not replace), remove path and rename again.
+     *
+     * Side Effects:
+     *  - Replaces path; the fallback briefly leaves no file at path.
+     */
+    bool replaceWithTemp(const std::string &tmp, const std::string &path);
+
+} // namespace ReportCard
+
+#endif // FILE_IO_H
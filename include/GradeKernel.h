@@ -0,0 +1,46 @@
+#ifndef GRADE_KERNEL_H
+#define GRADE_KERNEL_H
+
+#include "Student.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace ReportCard
+{
+
+    /**
+     * Objective:
+     *  Compute total, percentage, grade and pass flag for many students at once.
+     *
+     * Input:
+     *  @param marks const int* - flat marks matrix; row i is marks[offsets[i] .. offsets[i + 1])
+     *  @param offsets const std::size_t* - rows + 1 ascending offsets into marks
+     *  @param rows std::size_t - number of rows
+     *  @param totals int* - out, one per row
+     *  @param percentages double* - out, one per row
+     *  @param grades Grade* - out, one per row
+     *  @param pass std::uint8_t* - out, 1 if passed
+     *
+     * Output: None (results written to the output arrays)
+     * Approach:
+     *  Rows are processed in runs of equal subject count. On x86 CPUs with AVX2 each run is
+     *  handled 8 rows at a time (gathered column sums, packed double percentage and grade
+     *  compares); other rows and CPUs use the scalar path. Both paths evaluate exactly the
+     *  expressions Student::recalculate() uses, so results are bit-identical to it.
+     *
+     * Side Effects:
+     *  - Writes the output arrays only.
+     */
+    void gradeRows(const int *marks, const std::size_t *offsets, std::size_t rows,
+                   int *totals, double *percentages, Grade *grades, std::uint8_t *pass);
+
+    /// Scalar-only version of gradeRows() (reference path and benchmark baseline).
+    void gradeRowsScalar(const int *marks, const std::size_t *offsets, std::size_t rows,
+                         int *totals, double *percentages, Grade *grades, std::uint8_t *pass);
+
+    /// True if gradeRows() dispatches to the AVX2 kernel on this machine.
+    bool gradeKernelUsesSimd();
+
+} // namespace ReportCard
+
+#endif // GRADE_KERNEL_H
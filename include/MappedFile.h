@@ -0,0 +1,53 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ReportCard
+{
+
+    /**
+     * @class MappedFile
+     * @brief Read-only view of a whole file, memory-mapped where the platform allows it.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * Objective:
+         *  Map a file into memory for read-only scanning.
+         *
+         * Input:
+         *  @param path std::string - file to map
+         * Output: MappedFile; isOpen() reports whether the file could be opened
+         * Approach: open + fstat + mmap(PROT_READ) on POSIX; on other platforms the file is
+         *  read into an owned buffer so callers see the same interface.
+         *
+         * Side Effects:
+         *  - Opens the file and maps it (released by the destructor).
+         */
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // --- Accessors (no side effects — pure) ---
+        bool isOpen() const;
+        const char *data() const;
+        std::size_t size() const;
+        std::string_view view() const;
+
+    private:
+        const char *data_;
+        std::size_t size_;
+        bool open_;
+        bool mapped_;
+        std::string buffer_; // fallback storage when mmap is unavailable
+    };
+
+} // namespace ReportCard
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,134 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ReportCard
+{
+
+    /// Timed operations. Each has a call count and a latency histogram.
+    enum class MetricOp : unsigned
+    {
+        Load,          // StudentManager::loadFromFile (CSV or snapshot, plus journal replay)
+        Save,          // full CSV rewrite: saveToFile() or a write-behind pass
+        JournalAppend, // one journaled change (or batch)
+        Lookup,        // findByRoll
+        ClassQuery,    // getStudentsByClass / getClassView
+        Sort,          // sortByPercentageDesc
+        Count
+    };
+
+    /// Plain counters.
+    enum class MetricCounter : unsigned
+    {
+        BytesRead,     // data file and snapshot bytes read by loads
+        BytesWritten,  // CSV, snapshot and journal bytes written
+        RecordsLoaded, // students in memory after each load
+        ParseFailures, // CSV lines fromCSV rejected (and skipped) during loads
+        Count
+    };
+
+    /// Copy of every metric at one moment (see Metrics::snapshot()).
+    struct MetricsSnapshot
+    {
+        /// Upper bounds of the latency buckets in nanoseconds; the last bucket is +Inf.
+        static constexpr std::array<std::uint64_t, 9> kBucketBoundsNs = {
+            100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000};
+        static constexpr std::size_t kBuckets = kBucketBoundsNs.size() + 1;
+
+        struct OpStats
+        {
+            std::uint64_t calls = 0;
+            std::uint64_t totalNs = 0;
+            std::array<std::uint64_t, kBuckets> buckets{}; // per bucket, not cumulative
+
+            /// Upper bound (ns) of the bucket holding quantile q (0..1); 0 if no calls,
+            /// UINT64_MAX if it falls in the +Inf bucket.
+            std::uint64_t quantileUpperNs(double q) const;
+        };
+
+        std::array<OpStats, static_cast<std::size_t>(MetricOp::Count)> ops{};
+        std::array<std::uint64_t, static_cast<std::size_t>(MetricCounter::Count)> counters{};
+    };
+
+    /**
+     * @class Metrics
+     * @brief Process-wide instrumentation of StudentManager's load, save, lookup and sort paths.
+     *
+     * Timing is off by default. While it is off a Timer costs one relaxed atomic load and
+     * never reads the clock, so instrumented hot paths (findByRoll) run at full speed. Counters
+     * are bumped once per file operation, never per record, and are always kept, so parse
+     * failures are never silently lost. All members are thread-safe.
+     */
+    class Metrics
+    {
+    public:
+        /// Turn latency timing on or off (counters are unaffected).
+        static void setEnabled(bool enabled);
+        static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        static void record(MetricOp op, std::chrono::nanoseconds elapsed);
+        static void add(MetricCounter counter, std::uint64_t amount);
+
+        /// Current values. Fields are read one by one, so a concurrent update may be half seen.
+        static MetricsSnapshot snapshot();
+        /// Zero every metric.
+        static void reset();
+
+        static const char *name(MetricOp op);
+        static const char *name(MetricCounter counter);
+
+        /**
+         * Objective:
+         *  Render every metric in the Prometheus text exposition format.
+         *
+         * Input: None
+         * Output: text with one histogram (reportcard_operation_duration_seconds, labelled by
+         *  op) and one counter per MetricCounter
+         * Approach: snapshot(), then cumulative buckets as Prometheus expects.
+         *
+         * Side Effects: None
+         */
+        static std::string toPrometheus();
+
+        /// Human-readable table (calls, mean and approximate p50/p99 per op, then counters).
+        static std::string toText();
+
+        /// Write toPrometheus() to path (through a temporary file); false on I/O failure.
+        static bool writePrometheus(const std::string &path);
+
+        /// Times the enclosing scope into one op; does nothing while timing is disabled.
+        class Timer
+        {
+        public:
+            explicit Timer(MetricOp op) : op_(op), active_(Metrics::enabled())
+            {
+                if (active_)
+                    start_ = std::chrono::steady_clock::now();
+            }
+            ~Timer()
+            {
+                if (active_)
+                    Metrics::record(op_, std::chrono::steady_clock::now() - start_);
+            }
+            Timer(const Timer &) = delete;
+            Timer &operator=(const Timer &) = delete;
+
+        private:
+            MetricOp op_;
+            bool active_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+    private:
+        static std::atomic<bool> enabled_;
+    };
+
+} // namespace ReportCard
+
+#endif // METRICS_H
@@ -0,0 +1,41 @@
+#ifndef RANKING_H
+#define RANKING_H
+
+#include "StudentTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ReportCard
+{
+
+    /// School-wide percentage ranking of a StudentTable's rows (see rankRows()).
+    struct RankingResult
+    {
+        std::vector<std::uint32_t> order;           // rows, best first
+        std::vector<std::uint32_t> competitionRank; // per position in order: 1, 2, 2, 4, ...
+        std::vector<std::uint32_t> denseRank;       // per position in order: 1, 2, 2, 3, ...
+    };
+
+    /**
+     * Objective:
+     *  Rank every row by percentage without moving any student.
+     *
+     * Input:
+     *  @param table const StudentTable& - percentage, total, class and roll columns
+     *  @param threads unsigned - sort workers (0 = one per hardware thread)
+     * Output: RankingResult; ranks treat equal percentages as ties
+     * Approach: one compact key per row (percentage, total, class-name ordinal, roll, row).
+     *  Keys are sorted by percentage desc, then total desc, class name asc and roll asc (row
+     *  last, so the order is total and deterministic). Large inputs are cut into one chunk
+     *  per worker, sorted in parallel and merged pairwise in parallel rounds. Ranks come from
+     *  one pass over the sorted keys.
+     *
+     * Side Effects:
+     *  - None (may start and join worker threads).
+     */
+    RankingResult rankRows(const StudentTable &table, unsigned threads = 0);
+
+} // namespace ReportCard
+
+#endif // RANKING_H
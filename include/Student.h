@@ -1,15 +1,73 @@
 #ifndef STUDENT_H
 #define STUDENT_H
 
+#include "ClassNames.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ReportCard
 {
 
+    class BinaryReader;
+
+    /// Letter grades, best first. The underlying value is the grade code stored in snapshots.
+    enum class Grade : unsigned char
+    {
+        APlus = 0,
+        A,
+        BPlus,
+        B,
+        C,
+        F
+    };
+
+    /// Number of Grade values (size of per-grade histograms).
+    const int kGradeCount = 6;
+
+    // --- Grade helpers (pure) ---
+    /// Grade for a percentage using the brackets applied by Student::recalculate().
+    Grade gradeForPercentage(double percentage);
+    /// Display text for a grade ("A+", "A", "B+", "B", "C", "F").
+    std::string_view gradeName(Grade grade);
+    /// Inverse of gradeName(); returns false for unknown text.
+    bool parseGrade(std::string_view text, Grade &outGrade);
+
+    /**
+     * @class MarkSpan
+     * @brief Read-only, non-owning view of a student's marks (a C++17 stand-in for std::span).
+     *
+     * Like a reference returned by an accessor, a span is invalidated by the next change to
+     * the student's marks.
+     */
+    class MarkSpan
+    {
+    public:
+        MarkSpan(const int *data, std::size_t size) : data_(data), size_(size) {}
+
+        const int *begin() const { return data_; }
+        const int *end() const { return data_ + size_; }
+        const int *data() const { return data_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        int operator[](std::size_t i) const { return data_[i]; }
+
+    private:
+        const int *data_;
+        std::size_t size_;
+    };
+
     /**
      * @class Student
      * @brief Holds data for one student and provides grade/result calculations.
+     *
+     * Name, comment and marks are allocated from a std::pmr memory resource chosen at
+     * construction (the default heap unless one is given). Copies always use the default
+     * resource, so a copy never outlives the arena of the student it was taken from. The pmr
+     * storage stays private: accessors hand out std::string_view / MarkSpan views of it.
      */
     class Student
     {
@@ -28,6 +86,20 @@ namespace ReportCard
          */
         Student();
 
+        /**
+         * Objective:
+         *  Create an empty student whose strings and marks allocate from `resource`.
+         *
+         * Input:
+         *  @param resource std::pmr::memory_resource* - e.g. a StudentManager load arena
+         * Output: Default-valued Student
+         * Approach: pmr members are bound to resource; later fromCSV()/fromBinary() fill them.
+         *
+         * Side Effects:
+         *  - None beyond initialization (the resource must outlive the student).
+         */
+        explicit Student(std::pmr::memory_resource *resource);
+
         /**
          * Objective:
          *  Create a student object with all basic data and marks.
@@ -47,17 +119,22 @@ namespace ReportCard
         Student(const std::string &name, const std::string &className, int roll, const std::vector<int> &marks);
 
         // --- Accessors (no side effects — pure) ---
-        const std::string &getName() const;
+        // Views into the student's own storage; valid until the student is next modified.
+        std::string_view getName() const;
         const std::string &getClassName() const;
+        /// Interned id of the class name (see ClassNames); equal ids mean equal names.
+        std::uint32_t getClassId() const;
         int getRoll() const;
-        const std::vector<int> &getMarks() const;
+        MarkSpan getMarks() const;
         int getTotal() const;
         double getPercentage() const;
-        std::string getGrade() const;
+        /// Display text of the grade ("A+" ... "F"); views static storage.
+        std::string_view getGrade() const;
+        Grade getGradeCode() const;
         bool isPass() const;
 
         // 🌟 NEW ACCESSOR: Teacher Comment
-        const std::string &getTeacherComment() const;
+        std::string_view getTeacherComment() const;
 
         // --- Mutator for Teacher Comment ---
         /**
@@ -87,6 +164,52 @@ namespace ReportCard
          */
         void recalculate();
 
+        /**
+         * Objective:
+         *  Replace all marks in place and refresh the computed fields.
+         *
+         * Input:
+         *  @param marks const std::vector<int>& - new marks per subject
+         * Output: None
+         * Approach: assign into the existing marks storage (keeping its allocator), sum once,
+         *  then derive percentage, grade and pass from the total.
+         *
+         * Side Effects:
+         *  - Mutates marks_, total_, percentage_, grade_, pass_; name, class and teacher
+         *    comment are untouched.
+         */
+        void setMarks(const std::vector<int> &marks);
+
+        /**
+         * Objective:
+         *  Change one subject's mark and adjust the computed fields from the difference.
+         *
+         * Input:
+         *  @param subject std::size_t - zero-based subject index
+         *  @param mark int - new mark
+         * Output: false if subject is out of range (nothing changes)
+         * Approach: total_ += mark - old mark; percentage, grade and pass are then derived from
+         *  the total exactly as recalculate() would, so results are identical.
+         *
+         * Side Effects:
+         *  - Mutates one mark and the computed fields.
+         */
+        bool setMark(std::size_t subject, int mark);
+
+        /**
+         * Objective:
+         *  Store computed fields produced in bulk by gradeRows() for this student's marks.
+         *
+         * Input:
+         *  @param total int, @param percentage double, @param grade Grade, @param pass bool
+         * Output: None
+         * Approach: direct assignment; the caller guarantees the values came from getMarks().
+         *
+         * Side Effects:
+         *  - Mutates total_, percentage_, grade_, pass_.
+         */
+        void applyGradeResult(int total, double percentage, Grade grade, bool pass);
+
         /**
          * Objective:
          *  Serialize student to a single CSV line for file storage.
@@ -100,20 +223,67 @@ namespace ReportCard
          */
         std::string toCSV() const;
 
+        /**
+         * Objective:
+         *  Append the CSV line (without newline) to a caller-owned buffer.
+         *
+         * Input:
+         *  @param out std::string& - buffer reused across records by the caller
+         * Output: None (same text as toCSV())
+         * Approach: fields are escaped and numbers formatted with std::to_chars directly into
+         *  out; no temporary strings or streams.
+         *
+         * Side Effects:
+         *  - Appends to out only.
+         */
+        void appendCSV(std::string &out) const;
+
         /**
          * Objective:
          *  Parse a CSV line (as produced by toCSV) and populate the Student object.
          *
          * Input:
-         *  @param line std::string - CSV line
-         * Output: true if success, false otherwise
-         * Approach: Split fields carefully, parse marks list and other fields.
+         *  @param line std::string_view - CSV line (may point into a mapped file)
+         * Output: true if success, false otherwise (outStudent untouched on failure)
+         * Approach: Scan field boundaries as views without copying, unescape strings straight
+         *  into outStudent's members and parse numbers with std::from_chars.
          *
          * Side Effects:
          *  - Mutates outStudent's internal fields.
          *  - Calls recalculate(), which further mutates computed fields.
          */
-        static bool fromCSV(const std::string &line, Student &outStudent);
+        static bool fromCSV(std::string_view line, Student &outStudent);
+
+        /**
+         * Objective:
+         *  Append the student's binary snapshot record to a buffer.
+         *
+         * Input:
+         *  @param out std::string& - buffer to append to
+         * Output: None
+         * Approach: length-prefixed strings, roll, mark count and packed marks, then the
+         *  precomputed total, percentage, grade code and pass flag (little-endian).
+         *
+         * Side Effects:
+         *  - Appends to out only (student state untouched).
+         */
+        void appendBinary(std::string &out) const;
+
+        /**
+         * Objective:
+         *  Read one binary snapshot record (as written by appendBinary).
+         *
+         * Input:
+         *  @param in BinaryReader& - cursor positioned at a record
+         *  @param outStudent Student& - receives the record
+         * Output: true if a complete, valid record was read
+         * Approach: decode fields in order; computed fields are taken from the record as-is,
+         *  so no recalculate() is needed.
+         *
+         * Side Effects:
+         *  - Advances in and mutates outStudent.
+         */
+        static bool fromBinary(BinaryReader &in, Student &outStudent);
 
         /**
          * Objective:
@@ -128,20 +298,39 @@ namespace ReportCard
          */
         std::string formattedReportCard() const;
 
+        /**
+         * Objective:
+         *  Append the report card text to a caller-owned buffer (streaming form of
+         *  formattedReportCard()).
+         *
+         * Input:
+         *  @param out std::string& - growable buffer, reused across students by the caller
+         * Output: None (byte-for-byte the same text formattedReportCard() returns)
+         * Approach: fixed template sections are appended as constants; numbers are formatted
+         *  with std::to_chars (no locale, no stream state).
+         *
+         * Side Effects:
+         *  - Appends to out only.
+         */
+        void appendReportCard(std::string &out) const;
+
     private:
-        std::string name_;
-        std::string className_;
+        // Derive percentage_, grade_ and pass_ from total_ and the subject count.
+        void refreshFromTotal();
+
+        std::pmr::string name_;
+        const ClassName *class_; // interned, shared by every student of the class
         int roll_;
-        std::vector<int> marks_;
+        std::pmr::vector<int> marks_;
 
         // computed
         int total_;
         double percentage_;
-        std::string grade_;
+        Grade grade_;
         bool pass_;
 
         // 🌟 NEW MEMBER: Teacher Comments
-        std::string teacherComment_;
+        std::pmr::string teacherComment_;
     };
 
 } // namespace ReportCard
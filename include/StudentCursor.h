@@ -0,0 +1,136 @@
+#ifndef STUDENT_CURSOR_H
+#define STUDENT_CURSOR_H
+
+#include "Student.h"
+#include "StudentTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ReportCard
+{
+
+    /// Which records a StudentCursor yields. Default-constructed, it matches every record.
+    struct ScanFilter
+    {
+        enum class Result
+        {
+            Any,
+            Passed,
+            Failed
+        };
+
+        std::string className; // empty for every class
+        Result result = Result::Any;
+        double minPercentage = -std::numeric_limits<double>::infinity(); // inclusive
+        double maxPercentage = std::numeric_limits<double>::infinity();  // inclusive
+
+        bool matches(const Student &s) const;
+    };
+
+    /**
+     * @class StudentCursor
+     * @brief Forward-only scan of a students CSV that never holds more than one record.
+     *
+     * For data sets too large to load into a StudentManager. The file is read through one
+     * fixed-size buffer and every record is parsed into the same Student, so memory use does
+     * not depend on the file size (only a line longer than the buffer grows it). Lines
+     * fromCSV rejects are skipped and counted. The cursor reads the CSV as it is on disk:
+     * changes still waiting in a StudentManager journal are not seen, so checkpoint() first.
+     */
+    class StudentCursor
+    {
+    public:
+        /**
+         * Objective:
+         *  Open a CSV for a filtered forward scan.
+         *
+         * Input:
+         *  @param path std::string - students CSV (the StudentManager data file format)
+         *  @param filter ScanFilter - records that next() stops at
+         *  @param bufferBytes std::size_t - read buffer size
+         * Output: cursor positioned before the first record; isOpen() reports failure
+         * Approach: opens the file; nothing is read until next().
+         *
+         * Side Effects:
+         *  - Opens the file (closed by the destructor).
+         */
+        explicit StudentCursor(const std::string &path, ScanFilter filter = ScanFilter(),
+                               std::size_t bufferBytes = 1 << 20);
+
+        bool isOpen() const;
+
+        /**
+         * Objective:
+         *  Advance to the next record that passes the filter.
+         *
+         * Input: None
+         * Output: true if current() now holds such a record; false at end of file
+         * Approach: take the next '\n'-terminated line from the buffer (refilling it and
+         *  moving a partial line to the front as needed), parse it into the reused Student
+         *  and test the filter.
+         *
+         * Side Effects:
+         *  - Reads from the file; invalidates the previous current().
+         */
+        bool next();
+
+        /// The record next() stopped at; overwritten by the following next().
+        const Student &current() const;
+        /// Byte offset and length (without the '\n') of current()'s line in the file.
+        std::uint64_t currentOffset() const;
+        std::size_t currentLength() const;
+
+        std::size_t recordsRead() const;   // parsed records, matching or not
+        std::size_t parseFailures() const; // non-empty lines fromCSV rejected
+
+    private:
+        bool nextLine(std::string_view &line);
+
+        std::ifstream in_;
+        ScanFilter filter_;
+        std::vector<char> buffer_;
+        std::size_t begin_ = 0; // unread bytes are buffer_[begin_, end_)
+        std::size_t end_ = 0;
+        std::uint64_t bufferOffset_ = 0; // file offset of buffer_[0]
+        std::uint64_t lineOffset_ = 0;
+        std::size_t lineLength_ = 0;
+        bool eof_ = false;
+        Student current_;
+        std::size_t recordsRead_ = 0;
+        std::size_t parseFailures_ = 0;
+    };
+
+    /// Aggregates of one scan (see scanSummaries()).
+    struct ScanSummary
+    {
+        ClassSummary all;                                          // every matching record
+        std::vector<std::pair<std::string, ClassSummary>> byClass; // sorted by class name
+        std::size_t recordsRead = 0;
+        std::size_t parseFailures = 0;
+    };
+
+    /**
+     * Objective:
+     *  Summarise the records of a CSV that pass a filter, overall and per class.
+     *
+     * Input:
+     *  @param path std::string - students CSV
+     *  @param filter ScanFilter - records to include
+     *  @param out ScanSummary& - filled with the results
+     * Output: false if the file could not be opened
+     * Approach: one StudentCursor pass, folding each match into ClassSummary totals; memory
+     *  grows with the number of classes, not records.
+     *
+     * Side Effects:
+     *  - Reads the file.
+     */
+    bool scanSummaries(const std::string &path, const ScanFilter &filter, ScanSummary &out);
+
+} // namespace ReportCard
+
+#endif // STUDENT_CURSOR_H
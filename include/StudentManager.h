@@ -2,12 +2,152 @@
 #define STUDENT_MANAGER_H
 
 #include "Student.h"
+#include "StudentTable.h"
 #include <vector>
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <string_view>
+#include <utility>
 
 namespace ReportCard
 {
 
+    /**
+     * @class StudentRange
+     * @brief Read-only, non-owning view of selected stored students (no copies).
+     *
+     * Holds a reference to the manager's storage and to a list of positions in it; iterating
+     * yields const Student&. Like pointers from findByRoll(), a range is invalidated by the
+     * next mutation of the manager.
+     */
+    class StudentRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Student;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Student *;
+            using reference = const Student &;
+
+            iterator(const Student *base, const std::size_t *pos) : base_(base), pos_(pos) {}
+            reference operator*() const { return base_[*pos_]; }
+            pointer operator->() const { return &base_[*pos_]; }
+            iterator &operator++()
+            {
+                ++pos_;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator old = *this;
+                ++pos_;
+                return old;
+            }
+            bool operator==(const iterator &other) const { return pos_ == other.pos_; }
+            bool operator!=(const iterator &other) const { return pos_ != other.pos_; }
+
+        private:
+            const Student *base_;
+            const std::size_t *pos_;
+        };
+
+        StudentRange() : base_(nullptr), positions_(nullptr) {}
+        StudentRange(const std::vector<Student> &students, const std::vector<std::size_t> &positions)
+            : base_(students.data()), positions_(&positions) {}
+
+        iterator begin() const { return positions_ ? iterator(base_, positions_->data()) : iterator(base_, nullptr); }
+        iterator end() const { return positions_ ? iterator(base_, positions_->data() + positions_->size()) : iterator(base_, nullptr); }
+        std::size_t size() const { return positions_ ? positions_->size() : 0; }
+        bool empty() const { return size() == 0; }
+        const Student &operator[](std::size_t i) const { return base_[(*positions_)[i]]; }
+
+    private:
+        const Student *base_;
+        const std::vector<std::size_t> *positions_;
+    };
+
+    /**
+     * @class StudentBatch
+     * @brief Ordered list of mutations to apply to a StudentManager in one commit.
+     *
+     * Recording an operation does nothing to the manager; see StudentManager::commitBatch().
+     */
+    class StudentBatch
+    {
+    public:
+        // --- Recorders (same meaning as the StudentManager methods of the same name) ---
+        void addStudent(const Student &s);
+        void editMarks(int roll, const std::vector<int> &newMarks);
+        void editTeacherComment(int roll, const std::string &comment);
+        void removeByRoll(int roll);
+
+        std::size_t size() const;
+        bool empty() const;
+        void clear();
+
+    private:
+        friend class StudentManager;
+
+        struct Operation
+        {
+            enum class Kind
+            {
+                Add,
+                EditMarks,
+                EditComment,
+                Remove
+            };
+            Kind kind;
+            int roll;
+            Student student;        // Add
+            std::vector<int> marks; // EditMarks
+            std::string comment;    // EditComment
+        };
+
+        std::vector<Operation> ops_;
+    };
+
+    /// One row of StudentManager::ranking().
+    struct RankedStudent
+    {
+        const Student *student;
+        std::size_t competitionRank; // 1, 2, 2, 4: ties share a rank, the next one skips
+        std::size_t denseRank;       // 1, 2, 2, 3: no gaps after ties
+    };
+
+    /// Outcome of StudentManager::commitBatch().
+    struct BatchResult
+    {
+        bool committed = false;                   // true if every operation was applied and persisted
+        std::size_t applied = 0;                  // operations applied (all or none)
+        std::size_t rejected = 0;                 // operations that failed validation
+        std::vector<std::size_t> rejectedIndexes; // positions of the rejected operations in the batch
+    };
+
+    /// Outcome of StudentManager::exportReportCards().
+    struct ExportResult
+    {
+        std::size_t written = 0;  // files written successfully
+        std::uintmax_t bytes = 0; // bytes written across all files
+        double seconds = 0.0;     // wall-clock time of the export
+        std::vector<std::pair<std::string, std::string>> failures; // (path, reason) per failed file
+
+        double cardsPerSecond() const { return seconds > 0 ? written / seconds : 0.0; }
+    };
+
     /**
      * @class StudentManager
      * @brief Manages collection of Student objects, file operations and UI-level operations.
@@ -21,6 +161,8 @@ namespace ReportCard
          *
          * Input:
          *  @param filename std::string - path to CSV storage file
+         *  @param loadThreads unsigned - parse threads for loading (see setLoadThreads)
+         *  @param arenaStorage bool - load records into arenas (see setArenaStorage)
          * Output: constructed StudentManager
          * Approach: store filename and try to load existing records.
          *
@@ -28,7 +170,12 @@ namespace ReportCard
          *  - Calls loadFromFile(), which reads from disk and populates internal container.
          *  - Mutates internal list of students during construction.
          */
-        explicit StudentManager(const std::string &filename);
+        explicit StudentManager(const std::string &filename, unsigned loadThreads = 1, bool arenaStorage = false);
+
+        /// Stops the write-behind thread, if any, after flushing pending changes.
+        ~StudentManager();
+        StudentManager(const StudentManager &) = delete;
+        StudentManager &operator=(const StudentManager &) = delete;
 
         /**
          * Objective:
@@ -45,6 +192,38 @@ namespace ReportCard
          */
         bool addStudent(const Student &s);
 
+        /**
+         * Objective:
+         *  Start an empty batch of mutations.
+         *
+         * Input: None
+         * Output: StudentBatch to record operations into
+         * Approach: batches are plain values; nothing happens until commitBatch().
+         *
+         * Side Effects:
+         *  - None.
+         */
+        StudentBatch beginBatch() const;
+
+        /**
+         * Objective:
+         *  Apply a batch of mutations atomically with a single durable write.
+         *
+         * Input:
+         *  @param batch const StudentBatch& - operations in the order they should apply
+         * Output: BatchResult with applied/rejected counts
+         * Approach:
+         *  1. Validate every operation in order against a shadow of the (class, roll) keys it
+         *     touches, so later operations see the effect of earlier ones (add then edit works).
+         *  2. If any operation is rejected, stop: nothing is applied.
+         *  3. Otherwise apply all operations in memory and persist once (one journal group or
+         *     one CSV rewrite). If that write fails, memory is reloaded from disk.
+         *
+         * Side Effects:
+         *  - Mutates students_ and writes to disk only when the whole batch is valid.
+         */
+        BatchResult commitBatch(const StudentBatch &batch);
+
         /**
          * Objective:
          *  Get all students currently in memory.
@@ -65,13 +244,15 @@ namespace ReportCard
          * Input:
          *  @param roll int - roll number to search
          * Output: pointer to student in container or nullptr if not found
-         * Approach: linear search by roll (data is small; simple).
+         * Approach: roll index lookup; returns the first stored student with that roll.
          *
          * Side Effects:
          *  - Returns a pointer to internal object, allowing caller to modify object state.
          *    (Indirect side effect potential).
          */
         Student *findByRoll(int roll);
+        /// Read-only lookup (same rules as above); safe alongside other const calls.
+        const Student *findByRoll(int roll) const;
 
         /**
          * Objective:
@@ -97,7 +278,8 @@ namespace ReportCard
          *  @param roll int
          *  @param newMarks const std::vector<int>&
          * Output: true if edited, false if student not found
-         * Approach: find student, replace marks, recalc, save file.
+         * Approach: find student, replace its marks in place (Student::setMarks), refresh its
+         *  table row, persist. The teacher comment is kept.
          *
          * Side Effects:
          *  - Mutates Student's internal mark list & computed fields.
@@ -105,13 +287,32 @@ namespace ReportCard
          */
         bool editMarks(int roll, const std::vector<int> &newMarks);
 
+        /**
+         * Objective:
+         *  Edit one subject's mark.
+         *
+         * Input:
+         *  @param roll int
+         *  @param subject std::size_t - zero-based subject index
+         *  @param mark int - new mark
+         * Output: true if edited, false if the student or subject does not exist
+         * Approach: Student::setMark adjusts total/percentage/grade/pass from the difference;
+         *  the table row and cached topper are updated in O(1) (a rescan only if the topper
+         *  itself dropped). Persisted as the student's full marks record.
+         *
+         * Side Effects:
+         *  - Mutates one mark and the student's computed fields.
+         *  - Writes the change to storage.
+         */
+        bool editMark(int roll, std::size_t subject, int mark);
+
         /**
          * Objective:
          *  Return the topper (highest percentage). If tie, first highest is returned.
          *
          * Input: None
          * Output: pointer to topper or nullptr if no students
-         * Approach: linear scan tracking max percentage.
+         * Approach: the table maintains the topper row as students change; O(1).
          *
          * Side Effects:
          *  - None (read-only operation).
@@ -119,13 +320,125 @@ namespace ReportCard
          */
         const Student *getTopper() const;
 
+        /**
+         * Objective:
+         *  Get the k best students by percentage without reordering or saving anything.
+         *
+         * Input:
+         *  @param k std::size_t - how many students to return
+         * Output: up to k pointers, best first; ties keep storage order (like getTopper())
+         * Approach: partial selection over the table's percentage column (O(n log k)).
+         *
+         * Side Effects:
+         *  - None (read-only operation; pointers are invalidated by later mutations).
+         */
+        std::vector<const Student *> topK(std::size_t k) const;
+
+        /**
+         * Objective:
+         *  Get the k best students of one class by percentage.
+         *
+         * Input:
+         *  @param className std::string - class/section name
+         *  @param k std::size_t - how many students to return
+         * Output: up to k pointers, best first; empty if the class is unknown
+         * Approach: same partial selection as topK(), filtered on the class id column.
+         *
+         * Side Effects:
+         *  - None (read-only operation).
+         */
+        std::vector<const Student *> topKByClass(const std::string &className, std::size_t k) const;
+
+        /**
+         * Objective:
+         *  Get a student's position in the school-wide percentage ranking.
+         *
+         * Input:
+         *  @param roll int - roll number (first stored student with that roll)
+         * Output: 1-based competition rank (equal percentages share a rank), 0 if not found
+         * Approach: 1 + number of students with a strictly higher percentage, counted over the
+         *  contiguous percentage column.
+         *
+         * Side Effects:
+         *  - None (read-only operation).
+         */
+        std::size_t rankOf(int roll) const;
+
+        /**
+         * Objective:
+         *  Rank every student by percentage without reordering the stored data.
+         *
+         * Input:
+         *  @param threads unsigned - sort workers (0 = one per hardware thread)
+         * Output: all students best first, each with competition and dense rank (equal
+         *  percentages tie); equal percentages are ordered by total desc, class asc, roll asc
+         * Approach: rankRows() sorts compact keys built from the table columns.
+         *
+         * Side Effects:
+         *  - None (read-only operation; pointers are invalidated by later mutations).
+         */
+        std::vector<RankedStudent> ranking(unsigned threads = 0) const;
+
+        /**
+         * Objective:
+         *  Write every report card to a sink (bulk print/export).
+         *
+         * Input:
+         *  @param sink std::ostream& - destination (std::cout, a file, ...)
+         *  @param separator std::string_view - text written after each card (default none)
+         * Output: true if the sink accepted everything
+         * Approach: cards are appended with Student::appendReportCard into one reused buffer
+         *  that is handed to sink.write() in large blocks.
+         *
+         * Side Effects:
+         *  - Writes to sink.
+         */
+        bool renderAll(std::ostream &sink, std::string_view separator = {}) const;
+
+        /**
+         * Objective:
+         *  Export one report card file per student, using all cores.
+         *
+         * Input:
+         *  @param directory std::string - output root; files go to <directory>/<class>/<roll>.txt
+         *  @param threads unsigned - worker count (0 = one per hardware thread)
+         *  @param maxOpenFiles unsigned - upper bound on files open at the same time
+         * Output: ExportResult with counts, bytes, elapsed time and per-file failures
+         * Approach: class directories are created up front; workers then claim blocks of
+         *  students from a shared counter, render each card into a per-thread buffer and
+         *  write it while holding one of maxOpenFiles file slots. Class names are made
+         *  filesystem-safe (anything but letters, digits, '-', '_' and '.' becomes '_',
+         *  as does a leading '.'). Classes whose safe names match, ignoring case, get
+         *  "~2", "~3", ... appended in class-name order, so no two share a directory.
+         *
+         * Side Effects:
+         *  - Creates directories and writes files under directory.
+         */
+        ExportResult exportReportCards(const std::string &directory, unsigned threads = 0,
+                                       unsigned maxOpenFiles = 64) const;
+
+        /**
+         * Objective:
+         *  Expose the columnar view used for class-wide statistics.
+         *
+         * Input: None
+         * Output: const reference to the StudentTable (row i == getAll()[i])
+         * Approach: the table is kept in step with students_ on every mutation and reload.
+         *
+         * Side Effects:
+         *  - None (read-only reference).
+         */
+        const StudentTable &getTable() const;
+
         /**
          * Objective:
          *  Sort in-memory students by percentage descending.
          *
          * Input: None
          * Output: sorts container and returns void
-         * Approach: std::sort with comparator and then save file.
+         * Approach: rankRows() orders compact keys (ties: total desc, class asc, roll asc, so
+         *  the result is deterministic), then every student is moved once into its new
+         *  position and the change is persisted.
          *
          * Side Effects:
          *  - Mutates internal order of students_ vector.
@@ -133,13 +446,30 @@ namespace ReportCard
          */
         void sortByPercentageDesc();
 
+        /**
+         * Objective:
+         *  Regrade every student from their marks in one batch (e.g. after a grading change).
+         *
+         * Input: None
+         * Output: number of students whose total, percentage, grade or pass flag changed
+         * Approach: StudentTable::regrade() runs the vectorized gradeRows() kernel over the
+         *  flat marks matrix; changed rows are copied back into students_.
+         *
+         * Side Effects:
+         *  - Mutates computed fields of students_ and table_. Nothing is written to disk:
+         *    computed fields are always re-derived from marks on load.
+         */
+        std::size_t regradeAll();
+
         /**
          * Objective:
          *  Load students from file into memory (replaces memory).
          *
          * Input: None
-         * Output: true if success, false if file could not be opened
-         * Approach: read CSV lines and call Student::fromCSV
+         * Output: true if success (a missing file is an empty data set)
+         * Approach: memory-map the CSV, split it into lines as string views and call
+         *  Student::fromCSV on each (in parallel chunks when getLoadThreads() > 1, stitched
+         *  back in file order), then replay the journal.
          *
          * Side Effects:
          *  - Reads from disk.
@@ -153,7 +483,8 @@ namespace ReportCard
          *
          * Input: None
          * Output: true if success
-         * Approach: write to temporary file then rename for safety.
+         * Approach: Student::appendCSV into one reused buffer written in 1 MiB blocks to a
+         *  temporary file, then rename for safety.
          *
          * Side Effects:
          *  - Writes student list to disk (file I/O).
@@ -172,7 +503,7 @@ namespace ReportCard
          *  std::vector<Student> - list of students in that class
          *
          * Approach:
-         *  Filter students_ vector for matching className.
+         *  Copy the members listed by the class index (prefer getClassView() to avoid copies).
          *
          * Side Effects:
          *  - None (read-only operation).
@@ -180,6 +511,47 @@ namespace ReportCard
 
         std::vector<Student> getStudentsByClass(const std::string& className) const;
 
+        /**
+         * Objective:
+         *  View the students of one class without copying them.
+         *
+         * Input:
+         *  @param className std::string - class/section name
+         *
+         * Output:
+         *  StudentRange over the class members in storage order (empty if unknown class)
+         *
+         * Approach:
+         *  Class name -> interned id -> the table's per-class position list; O(1) to build,
+         *  iteration is proportional to class size with no per-student allocation.
+         *
+         * Side Effects:
+         *  - None (read-only; the range is invalidated by the next mutation).
+         */
+        StudentRange getClassView(const std::string &className) const;
+
+        /**
+         * Objective:
+         *  Get the live summary of one class: count, percentage sum/min/max, pass count, grade
+         *  histogram and per-subject mark sums.
+         *
+         * Input:
+         *  @param className std::string - class/section name
+         * Output: summary reference (empty summary for an unknown class)
+         * Approach: the table keeps one summary per class, adjusted by every add, edit and
+         *  remove; O(1) to read.
+         *
+         * Side Effects:
+         *  - None (read-only; the reference reflects later mutations as they happen).
+         */
+        const ClassSummary &getClassSummary(const std::string &className) const;
+
+        /// School-wide summary (same fields as getClassSummary, over every student); O(1).
+        const ClassSummary &getSchoolSummary() const;
+
+        /// Names of classes that currently have students, sorted.
+        std::vector<std::string> getClassNames() const;
+
 
         /**
          * Objective:
@@ -192,16 +564,371 @@ namespace ReportCard
          *  true if exists, false otherwise
          *
          * Approach:
-         *  Scan students_ vector for matching roll.
+         *  Roll index lookup (O(1) average).
          *
          * Side Effects:
          *  - None (read-only operation).
          */
         bool rollExists(int roll) const;
 
+        /**
+         * Objective:
+         *  Check if a roll number is already taken within a class.
+         *
+         * Input:
+         *  @param className std::string - class/section name
+         *  @param roll int - roll number to check
+         *
+         * Output:
+         *  true if a student with that (className, roll) exists
+         *
+         * Approach:
+         *  (className, roll) index lookup (O(1) average).
+         *
+         * Side Effects:
+         *  - None (read-only operation).
+         */
+        bool rollExistsInClass(const std::string &className, int roll) const;
+
+        /**
+         * Objective:
+         *  Switch between full-file persistence and journaled persistence.
+         *
+         * Input:
+         *  @param enabled bool - true to append mutations to a journal instead of rewriting the CSV
+         * Output: None
+         * Approach:
+         *  In journaled mode every mutation appends one small record to "<filename>.journal".
+         *  Once the journal holds as many records as the data set, a background thread
+         *  compacts it into a fresh CSV while edits keep appending. Turning the mode off
+         *  checkpoints first so the CSV is authoritative again.
+         *
+         * Side Effects:
+         *  - Starts the background writer (enabling) or writes the CSV, deletes the journal and
+         *    stops the writer unless async persistence still needs it (disabling).
+         */
+        void setJournaling(bool enabled);
+
+        /**
+         * Objective:
+         *  Report whether journaled persistence is active.
+         *
+         * Input: None
+         * Output: true if mutations are appended to the journal
+         * Approach: returns the mode flag.
+         *
+         * Side Effects:
+         *  - None (read-only operation).
+         */
+        bool isJournaling() const;
+
+        /**
+         * Objective:
+         *  Compact base CSV plus journal into a fresh CSV snapshot.
+         *
+         * Input: None
+         * Output: true if the snapshot was written
+         * Approach: saveToFile() writes the full snapshot, which also discards the journal.
+         *  While the background writer runs, the pass is handed to it and waited for.
+         *
+         * Side Effects:
+         *  - Writes student list to disk and removes the journal file.
+         */
+        bool checkpoint();
+
+        /**
+         * Objective:
+         *  Choose how many threads loadFromFile() may use to parse the CSV.
+         *
+         * Input:
+         *  @param threads unsigned - worker count; 0 means one per hardware thread, 1 disables
+         *  parallel parsing
+         * Output: None
+         * Approach: stores the setting; applies from the next loadFromFile() call.
+         *
+         * Side Effects:
+         *  - Mutates the load configuration only.
+         */
+        void setLoadThreads(unsigned threads);
+        unsigned getLoadThreads() const;
+
+        /**
+         * Objective:
+         *  Choose whether loadFromFile() allocates records from arenas instead of the heap.
+         *
+         * Input:
+         *  @param enabled bool - true to load names, comments and marks into monotonic arenas
+         * Output: None
+         * Approach: stores the setting; applies from the next loadFromFile() call. In arena
+         *  mode every loaded record draws from large slabs (one arena per parse worker) rather
+         *  than one malloc per string/marks list, and the slabs are freed together on the
+         *  following load. Students added later still use the heap.
+         *
+         * Side Effects:
+         *  - Mutates the load configuration only.
+         */
+        void setArenaStorage(bool enabled);
+        bool getArenaStorage() const;
+
+        /**
+         * Objective:
+         *  Write the in-memory data set as a binary snapshot (CSV -> binary conversion).
+         *
+         * Input:
+         *  @param path std::string - snapshot file to create
+         * Output: true if written
+         * Approach: versioned header, one Student::appendBinary record per student and a
+         *  trailing checksum; written to a temporary file and renamed.
+         *
+         * Side Effects:
+         *  - Writes a file to disk.
+         */
+        bool saveSnapshot(const std::string &path) const;
+
+        /**
+         * Objective:
+         *  Replace the data set with a binary snapshot (binary -> CSV conversion).
+         *
+         * Input:
+         *  @param path std::string - snapshot file to read
+         * Output: true if the snapshot was valid and the CSV was rewritten from it
+         * Approach: verify magic, version and checksum, decode records without re-parsing or
+         *  recalculating, then saveToFile() so the CSV (and any journal) match memory.
+         *
+         * Side Effects:
+         *  - Replaces students_ and rewrites the CSV. Memory is untouched if the file is invalid.
+         */
+        bool loadSnapshot(const std::string &path);
+
+        /**
+         * Objective:
+         *  Keep a binary snapshot "<filename>.snap" next to the CSV for fast start-up.
+         *
+         * Input:
+         *  @param enabled bool - true to refresh the snapshot on every saveToFile()
+         * Output: None
+         * Approach: the snapshot records the size and modification time of the CSV it mirrors;
+         *  loadFromFile() uses it only while the CSV still matches, whatever this setting is.
+         *
+         * Side Effects:
+         *  - Mutates configuration; later saves also write the snapshot.
+         */
+        void setSnapshotMirroring(bool enabled);
+
+        /**
+         * Objective:
+         *  Keep an on-disk index "<filename>.idx" next to the CSV (see DiskIndex).
+         *
+         * Input:
+         *  @param enabled bool - true to rewrite the index on every full save
+         * Output: None
+         * Approach: saveToFile() (and write-behind passes) note each record's offset while
+         *  serialising and write the sorted index straight after the CSV, without re-reading
+         *  it. Journaled changes reach the index at the next checkpoint.
+         *
+         * Side Effects:
+         *  - Mutates configuration; later saves also write the index.
+         */
+        void setDiskIndex(bool enabled);
+
+        /**
+         * Objective:
+         *  Write changes behind the caller instead of on every mutation.
+         *
+         * Input:
+         *  @param enabled bool - true to start the background writer, false to flush and stop it
+         *  @param delay std::chrono::milliseconds - how long a burst may grow after its first change
+         *  @param maxPendingChanges std::size_t - write early once this many changes are pending
+         * Output: None
+         * Approach: mutations only mark the store dirty and return. A background thread waits
+         *  for the delay or change count, encodes the CSV (and snapshot mirror) under a short
+         *  store lock, then rewrites the files without it, so a burst of edits costs one write.
+         *  With journaling on, each change is still appended to the journal before it is
+         *  queued, so a crash loses nothing, and every write also compacts the journal.
+         *
+         * Side Effects:
+         *  - Starts or stops a thread (the thread stays while journaling needs it); disk
+         *    writes happen on that thread.
+         */
+        void setAsyncPersistence(bool enabled,
+                                 std::chrono::milliseconds delay = std::chrono::milliseconds(500),
+                                 std::size_t maxPendingChanges = 256);
+        bool isAsyncPersistence() const;
+
+        /**
+         * Objective:
+         *  Wait until every change made so far is on disk.
+         *
+         * Input: None
+         * Output: true once written (always true when async persistence is off)
+         * Approach: wakes the background writer without waiting for the delay and blocks until
+         *  a write covering the latest change has finished.
+         *
+         * Side Effects:
+         *  - May trigger an immediate write.
+         */
+        bool flush();
+
     private:
+        // --- In-memory mutations (no persistence) ---
+        bool insertStudent(const Student &s);
+        bool eraseRoll(int roll);
+        bool replaceMarks(int roll, const std::vector<int> &newMarks);
+        bool replaceComment(int roll, const std::string &comment);
+        void reorderByPercentage();
+
+        // --- Persistence helpers ---
+        /**
+         * Objective:
+         *  Persist one mutation that has already been applied in memory.
+         *
+         * Input:
+         *  @param record std::string - journal record describing the mutation
+         * Output: true if the change is on disk (or, with only async persistence, queued)
+         * Approach: append the record when journaling (waking the background writer to compact
+         *  once the journal has grown as large as the data set); then, with async persistence,
+         *  queue a write-behind; otherwise rewrite the CSV.
+         *  Called with the store lock held, so a compaction pass never sees a change in memory
+         *  without its journal record.
+         *
+         * Side Effects:
+         *  - Appends to the journal or rewrites the CSV.
+         */
+        bool persist(const std::string &record);
+
+        /**
+         * Objective:
+         *  Persist several already-applied mutations with one write.
+         *
+         * Input:
+         *  @param records std::vector<std::string> - journal records in apply order
+         * Output: true if the changes are on disk
+         * Approach: one framed journal group ("B,<count>" + records) written at once, so replay
+         *  applies the whole group or none of it; otherwise a single CSV rewrite.
+         *
+         * Side Effects:
+         *  - Appends to the journal or rewrites the CSV.
+         */
+        bool persistRecords(const std::vector<std::string> &records);
+
+        /**
+         * Objective:
+         *  Re-apply journal records written since the last checkpoint.
+         *
+         * Input:
+         *  @param baseSize std::uint64_t - size of the CSV that was just loaded (0 if none)
+         *  @param baseMtime std::uint64_t - its modification time (0 if none)
+         * Output: None
+         * Approach: skip the journal if its header names a different base size or mtime (the
+         *  CSV was rewritten or replaced after the journal was started); otherwise apply each
+         *  record in order and ignore a torn trailing record.
+         *
+         * Side Effects:
+         *  - Reads the journal file and mutates students_.
+         */
+        void replayJournal(std::uint64_t baseSize, std::uint64_t baseMtime);
+        bool applyJournalRecord(const std::string &record);
+        std::string journalPath() const;
+        std::string snapshotPath() const;
+
+        /**
+         * Objective:
+         *  Load the mirrored snapshot instead of parsing the CSV, when it is current.
+         *
+         * Input:
+         *  @param csvSize std::uint64_t& - receives the CSV size on success
+         *  @param csvMtime std::uint64_t& - receives the CSV mtime on success
+         * Output: true if students_ was filled from the snapshot
+         * Approach: compare the snapshot's recorded CSV size/mtime with the CSV on disk.
+         *
+         * Side Effects:
+         *  - Reads the snapshot file and fills students_.
+         */
+        bool loadMirroredSnapshot(std::uint64_t &csvSize, std::uint64_t &csvMtime);
+
+        /// Resource for one serial load pass: a fresh arena (kept in arenas_) or the heap.
+        std::pmr::memory_resource *loadResource();
+
+        // --- Background writer (see setAsyncPersistence, setJournaling) ---
+        /// Lock taken by mutators while the background writer exists; empty otherwise.
+        std::unique_lock<std::mutex> lockStore() const;
+        void markDirty(std::size_t changes);
+        void startWriter();
+        void writeBehindLoop();
+        /// One coalesced write: encode under storeMutex_, write files under fileMutex_, then
+        /// move journal records appended meanwhile onto the new CSV.
+        bool writeBehind();
+        /// Flush, stop and join the writer; falls back to saveToFile() if the flush failed.
+        bool stopWriter();
+
+        /// Position in students_ of the first student with roll, or -1. Unmetered, so edits
+        /// that find their row here are not counted as findByRoll() lookups.
+        std::ptrdiff_t rowOfRoll(int roll) const;
+
+        // --- Lookup indexes (positions into students_) ---
+        struct ClassRollKey
+        {
+            std::uint32_t classId; // ClassNames id
+            int roll;
+            bool operator==(const ClassRollKey &other) const
+            {
+                return roll == other.roll && classId == other.classId;
+            }
+        };
+        struct ClassRollHash
+        {
+            std::size_t operator()(const ClassRollKey &key) const;
+        };
+
+        /**
+         * Objective:
+         *  Recompute both lookup indexes and the column table from students_.
+         *
+         * Input: None
+         * Output: None
+         * Approach: single pass over students_, recording each position; then table rebuild.
+         *
+         * Side Effects:
+         *  - Replaces keyIndex_, rollIndex_ and table_.
+         */
+        void rebuildIndex();
+
         std::string filename_;
+        // declared before students_ so the slabs outlive every record allocated from them
+        std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> arenas_;
         std::vector<Student> students_;
+
+        std::unordered_map<ClassRollKey, std::size_t, ClassRollHash> keyIndex_; // (class, roll) -> position
+        std::unordered_map<int, std::vector<std::size_t>> rollIndex_;           // roll -> positions, ascending
+        StudentTable table_;                                                    // columnar mirror of students_
+
+        unsigned loadThreads_ = 1;
+        bool arenaStorage_ = false;
+        bool mirrorSnapshot_ = false;
+        bool diskIndex_ = false;
+
+        bool journaling_ = false;
+        bool asyncPersistence_ = false;
+        mutable std::size_t journalRecords_ = 0; // records appended since the last snapshot
+        mutable std::uint64_t storeEpoch_ = 0;   // bumped by every reload and full save
+        bool compactionQueued_ = false;          // a full journal has woken the writer
+        std::uint64_t rowsVersion_ = 0;          // bumped when rows are added, removed or reordered
+
+        mutable std::mutex storeMutex_; // mutators and their journal appends vs. the writer
+        mutable std::mutex fileMutex_;  // saveToFile() vs. the writer's file replacement
+        std::mutex asyncMutex_;         // guards the fields below
+        std::condition_variable asyncCv_;
+        std::chrono::milliseconds asyncDelay_{500};
+        std::size_t asyncMaxPending_ = 256;
+        std::size_t pendingChanges_ = 0;
+        std::chrono::steady_clock::time_point firstPending_;
+        std::uint64_t changeSeq_ = 0;   // bumped by every markDirty()
+        std::uint64_t attemptedSeq_ = 0; // changeSeq_ covered by the last finished write attempt
+        std::uint64_t writtenSeq_ = 0;   // changeSeq_ covered by the last successful write
+        unsigned flushWaiters_ = 0;
+        bool checkpointDue_ = false; // compact now: the journal is full or checkpoint() waits
+        bool stopWriter_ = false;
+        std::thread writer_; // last member: started after, and joined before, everything else
     };
 
 } // namespace ReportCard
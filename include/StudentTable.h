@@ -0,0 +1,267 @@
+#ifndef STUDENT_TABLE_H
+#define STUDENT_TABLE_H
+
+#include "Student.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ReportCard
+{
+
+    /**
+     * @struct ClassSummary
+     * @brief Running totals for one class (or the whole school), kept current by StudentTable.
+     *
+     * Every field is adjusted as rows are added or changed, so reading a summary is O(1).
+     */
+    struct ClassSummary
+    {
+        std::size_t count = 0;
+        double percentageSum = 0.0;
+        double minPercentage = 0.0; // meaningful only when count > 0
+        double maxPercentage = 0.0;
+        std::size_t passCount = 0;
+        std::array<std::size_t, kGradeCount> gradeCounts{}; // indexed by Grade value
+        std::vector<long long> subjectSums;     // subject index -> sum of marks
+        std::vector<std::size_t> subjectCounts; // subject index -> students taking it
+
+        double averagePercentage() const; // 0 when empty
+        double passRate() const;          // 0..1, 0 when empty
+        double subjectAverage(std::size_t subject) const;
+
+        /// Fold in one student (for summaries built outside StudentTable, e.g. StudentCursor scans).
+        void add(const Student &s);
+    };
+
+    /**
+     * @class StudentTable
+     * @brief Column-oriented copy of the fields aggregates need, one row per stored student.
+     *
+     * Row i always describes StudentManager's students_[i]. Classes are keyed by their
+     * ClassNames id (shared with Student::getClassId()), and marks live in one flat array indexed by per-row offsets, so class-wide scans
+     * touch only the contiguous columns they read.
+     */
+    class StudentTable
+    {
+    public:
+        /// Pass as classId to aggregate over every class.
+        static const std::uint32_t kAllClasses = UINT32_MAX;
+
+        // --- Maintenance (called by StudentManager) ---
+        /**
+         * Objective:
+         *  Rebuild every column from a student list.
+         *
+         * Input:
+         *  @param students const std::vector<Student>& - rows in storage order
+         * Output: None
+         * Approach: clear the columns (per-class lists are kept, emptied) and append each student.
+         *
+         * Side Effects:
+         *  - Replaces all column contents.
+         */
+        void rebuild(const std::vector<Student> &students);
+
+        /**
+         * Objective:
+         *  Add a row for a student appended to storage.
+         *
+         * Input:
+         *  @param s const Student& - student stored at position size()
+         * Output: None
+         * Approach: push one value per column; marks go to the end of the flat matrix.
+         *
+         * Side Effects:
+         *  - Grows every column; may add a per-class row list.
+         */
+        void append(const Student &s);
+
+        /**
+         * Objective:
+         *  Refresh a row after the student's marks or class changed.
+         *
+         * Input:
+         *  @param row std::size_t - row to refresh
+         *  @param s const Student& - current state of the student
+         * Output: None
+         * Approach: overwrite scalar columns; marks are overwritten in place when the subject
+         *  count is unchanged, otherwise the flat matrix and later offsets are shifted.
+         *
+         * Side Effects:
+         *  - Mutates the row's column values.
+         */
+        void update(std::size_t row, const Student &s);
+
+        /**
+         * Objective:
+         *  Refresh a row after one subject's mark changed (Student::setMark).
+         *
+         * Input:
+         *  @param row std::size_t - row to refresh
+         *  @param subject std::size_t - subject that changed (in range for the row)
+         *  @param s const Student& - current state of the student
+         * Output: None
+         * Approach: overwrite the one marks cell and the computed columns; O(1).
+         *
+         * Side Effects:
+         *  - Mutates the row's column values.
+         */
+        void updateMark(std::size_t row, std::size_t subject, const Student &s);
+
+        void clear();
+
+        /**
+         * Objective:
+         *  Recompute total, percentage, grade and pass columns from the marks matrix.
+         *
+         * Input: None
+         * Output: None
+         * Approach: one gradeRows() batch call over marks()/markOffsets().
+         *
+         * Side Effects:
+         *  - Overwrites the computed columns of every row.
+         */
+        void regrade();
+
+        // --- Columns (read-only) ---
+        std::size_t size() const;
+        const std::vector<int> &rolls() const;
+        const std::vector<std::uint32_t> &classIds() const;
+        const std::vector<int> &totals() const;
+        const std::vector<double> &percentages() const;
+        const std::vector<Grade> &grades() const;
+        const std::vector<std::uint8_t> &passFlags() const;
+        /// Marks of row i are marks()[markOffsets()[i] .. markOffsets()[i + 1]).
+        const std::vector<int> &marks() const;
+        const std::vector<std::size_t> &markOffsets() const;
+
+        // --- Classes (ids come from ClassNames) ---
+        /// Id of a class name; returns false if the name was never interned.
+        bool findClass(std::string_view className, std::uint32_t &outId) const;
+        const std::string &className(std::uint32_t classId) const;
+        /// Upper bound on the class ids of stored rows (ids at or above it have no rows).
+        std::size_t classCount() const;
+
+        /**
+         * Objective:
+         *  List the rows belonging to one class.
+         *
+         * Input:
+         *  @param classId std::uint32_t - interned class id
+         * Output: ascending row indexes (empty for an unknown id)
+         * Approach: per-class row lists maintained by append/update/rebuild, so class queries
+         *  cost O(class size) instead of a scan of every row.
+         *
+         * Side Effects:
+         *  - None (read-only reference, invalidated by the next mutation).
+         */
+        const std::vector<std::size_t> &rowsOfClass(std::uint32_t classId) const;
+
+        // --- Aggregates (pure; count, average, pass rate and histogram read the summaries) ---
+        /**
+         * Objective:
+         *  Find the row with the highest percentage.
+         *
+         * Input:
+         *  @param classId std::uint32_t - restrict to one class, or kAllClasses
+         * Output: row index, or -1 if there are no matching rows
+         * Approach: the overall topper is maintained by every row change (O(1) to read); a
+         *  class topper is one pass over the class's rows. On ties the first row wins.
+         *
+         * Side Effects:
+         *  - None (read-only operation).
+         */
+        std::ptrdiff_t topperRow(std::uint32_t classId = kAllClasses) const;
+
+        /**
+         * Objective:
+         *  Select the k rows with the highest percentage without sorting the whole table.
+         *
+         * Input:
+         *  @param k std::size_t - number of rows wanted
+         *  @param classId std::uint32_t - restrict to one class, or kAllClasses
+         * Output: row indexes, best first (ties keep storage order, like topperRow())
+         * Approach: bounded heap of k candidates over the percentage column, O(n log k).
+         *
+         * Side Effects:
+         *  - None (read-only operation).
+         */
+        std::vector<std::size_t> topRows(std::size_t k, std::uint32_t classId = kAllClasses) const;
+
+        /// Number of rows (in a class, or overall) whose percentage is strictly above `percentage`.
+        std::size_t countAbove(double percentage, std::uint32_t classId = kAllClasses) const;
+
+        /// Number of rows in a class (or all rows).
+        std::size_t count(std::uint32_t classId = kAllClasses) const;
+        /// Mean percentage, 0 when there are no rows.
+        double averagePercentage(std::uint32_t classId = kAllClasses) const;
+        /// Fraction of rows with the pass flag set (0..1), 0 when there are no rows.
+        double passRate(std::uint32_t classId = kAllClasses) const;
+        /// Row count per Grade, indexed by the grade's underlying value.
+        std::array<std::size_t, kGradeCount> gradeHistogram(std::uint32_t classId = kAllClasses) const;
+
+        /**
+         * Objective:
+         *  Read the maintained summary of a class, or of every row.
+         *
+         * Input:
+         *  @param classId std::uint32_t - class id, or kAllClasses for the school-wide summary
+         * Output: summary reference (an empty summary for an unknown id)
+         * Approach: summaries are adjusted by each append/update/updateMark from the row's old
+         *  and new values; min/max are rescanned only when the row holding one moves inwards.
+         *
+         * Side Effects:
+         *  - None (read-only reference, invalidated by the next mutation).
+         */
+        const ClassSummary &summary(std::uint32_t classId = kAllClasses) const;
+
+    private:
+        std::vector<std::size_t> &rowsFor(std::uint32_t classId);
+        // Overwrite the computed columns of a row from s.
+        void setComputed(std::size_t row, const Student &s);
+        std::ptrdiff_t scanTopper() const;
+
+        // --- Summary maintenance: retire(row) before a row changes, admit(row) after, then
+        // settle() fixes the topper and any min/max the change invalidated. ---
+        void accumulate(ClassSummary &summary, std::size_t row, int sign) const;
+        void admit(std::size_t row);
+        void retire(std::size_t row);
+        void settle(std::size_t row, std::uint32_t oldClass, double before);
+        void rescanExtremes(std::uint32_t classId);
+
+        // Call fn(row) for every row of classId (ascending), or every row for kAllClasses.
+        template <typename Fn>
+        void forEachRow(std::uint32_t classId, Fn fn) const
+        {
+            if (classId == kAllClasses)
+            {
+                for (std::size_t i = 0; i < rolls_.size(); ++i)
+                    fn(i);
+                return;
+            }
+            for (std::size_t i : rowsOfClass(classId))
+                fn(i);
+        }
+
+        std::vector<int> rolls_;
+        std::vector<std::uint32_t> classIds_;
+        std::vector<int> totals_;
+        std::vector<double> percentages_;
+        std::vector<Grade> grades_;
+        std::vector<std::uint8_t> pass_;
+        std::vector<int> marks_;
+        std::vector<std::size_t> markOffsets_{0};
+
+        std::vector<std::vector<std::size_t>> classRows_; // class id -> rows, ascending
+        std::ptrdiff_t topRow_ = -1;                      // first row with the highest percentage
+        std::vector<ClassSummary> classSummaries_;        // class id -> summary
+        ClassSummary school_;                             // every row
+    };
+
+} // namespace ReportCard
+
+#endif // STUDENT_TABLE_H
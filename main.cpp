@@ -1,20 +1,64 @@
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <vector>
 #include <string>
 #include <limits>
 #include "StudentManager.h"
+#include "BatchCli.h"
+#include "DiskIndex.h"
+#include "Metrics.h"
 #include "Utils.h"
 
 using namespace std;
 using namespace ReportCard;
 using namespace RCUtils;
 
-int main()
+// Print one maintained class (or school) summary for option 12.
+static void printSummary(const string &label, const ClassSummary &s)
 {
+    cout << fixed << setprecision(2);
+    cout << label << ": " << s.count << " students";
+    if (s.count == 0)
+    {
+        cout << "\n";
+        return;
+    }
+    cout << ", average " << s.averagePercentage() << "%, min " << s.minPercentage << "%, max "
+         << s.maxPercentage << "%, pass " << s.passCount << " (" << 100.0 * s.passRate() << "%)\n";
+    cout << "  Grades  :";
+    for (int g = 0; g < kGradeCount; ++g)
+        cout << " " << gradeName(static_cast<Grade>(g)) << "=" << s.gradeCounts[g];
+    cout << "\n  Subjects:";
+    for (size_t j = 0; j < s.subjectSums.size(); ++j)
+        if (s.subjectCounts[j] > 0)
+            cout << " S" << (j + 1) << "=" << s.subjectAverage(j);
+    cout << "\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+int main(int argc, char **argv)
+{
+    // Any arguments select the non-interactive batch mode (no prompts, no menu)
+    if (argc > 1)
+        return runBatchCli(vector<string>(argv + 1, argv + argc), "data/students.csv", cout, cerr);
+
     cout << "Student Report Card Management System\n";
 
+    // Time loads, saves, lookups and sorts for the Statistics option (cheap at menu speed)
+    Metrics::setEnabled(true);
+
     // Manager responsible for storing, loading, and handling student records
     StudentManager mgr("data/students.csv");
+    // Append edits to a journal instead of rewriting the whole CSV on every change
+    mgr.setJournaling(true);
+    // Keep a binary mirror of the CSV so the next start-up skips text parsing
+    mgr.setSnapshotMirroring(true);
+    // Refresh data/students.csv.idx on save if one was built (`reportcard index`)
+    mgr.setDiskIndex(ifstream(DiskIndex::pathFor("data/students.csv")).good());
+    // Save in the background: menu edits return once journaled and bursts become one CSV write
+    mgr.setAsyncPersistence(true);
 
     while (true)
     {
@@ -30,6 +74,9 @@ int main()
         cout << "8. View Students by Class\n";
         cout << "9. Delete Student\n";      // <-- SHIFTED
         cout << "10. Exit\n";
+        cout << "11. Export Report Cards to Files\n";
+        cout << "12. Class Summaries\n";
+        cout << "13. Statistics\n";
 
         int choice = readInt("Choose option: ");
 
@@ -45,17 +92,7 @@ int main()
             {
                 roll = readInt("Roll no: ");
 
-                bool conflict = false;
-                for (const auto &s : mgr.getAll())
-                {
-                    if (s.getRoll() == roll && s.getClassName() == className)
-                    {
-                        conflict = true;
-                        break;
-                    }
-                }
-
-                if (conflict)
+                if (mgr.rollExistsInClass(className, roll))
                 {
                     cout << "Error: Roll " << roll << " already exists in class "
                          << className << ". Try another.\n";
@@ -96,8 +133,7 @@ int main()
             }
             else
             {
-                for (const auto &s : all)
-                    cout << s.formattedReportCard();
+                mgr.renderAll(cout);
             }
 
             pause();
@@ -161,6 +197,19 @@ int main()
                 cout << m << " ";
             cout << "\n";
 
+            // Edit a single subject in place
+            int subject = readInt("Subject to edit (0 = replace all marks): ");
+            if (subject > 0)
+            {
+                int m = readMark("New mark for subject " + to_string(subject) + " (0-100): ");
+                if (mgr.editMark(roll, static_cast<size_t>(subject - 1), m))
+                    cout << "Mark updated.\n";
+                else
+                    cout << "No such subject.\n";
+                pause();
+                continue;
+            }
+
             // Replace marks
             int subjects = readInt("Number of subjects (replace): ");
             vector<int> marks;
@@ -216,8 +265,8 @@ int main()
         else if (choice == 8)
         {
             string className = readLine("Enter class name: ");
-            // Get list of students in the specified class
-            auto list = mgr.getStudentsByClass(className);
+            // View the students of the specified class (no copies)
+            StudentRange list = mgr.getClassView(className);
 
             if (list.empty())
             {     // No students found
@@ -226,10 +275,13 @@ int main()
             else
             {    // Display students
                 cout << "Students in class " << className << ":\n";
+                string out;
                 for (const auto &s : list)
                 {
-                    cout << s.formattedReportCard() << "\n";
+                    s.appendReportCard(out);
+                    out += "\n";
                 }
+                cout << out;
             }
 
             pause();
@@ -251,10 +303,55 @@ int main()
         else if (choice == 10) // SHIFTED FROM 8
       
         {
+            // Write out anything still pending in the background before leaving
+            if (!mgr.flush())
+                cout << "Failed to save pending changes.\n";
             cout << "Exiting. Goodbye!\n";
             break;
         }
 
+        // ------------------------ EXPORT REPORT CARDS ------------------------
+        else if (choice == 11)
+        {
+            string dir = readLine("Output directory: ");
+
+            // One file per student, <dir>/<class>/<roll>.txt, written on all cores
+            ExportResult r = mgr.exportReportCards(dir.empty() ? "reportcards" : dir);
+            cout << "Exported " << r.written << " report cards (" << r.bytes << " bytes) in "
+                 << r.seconds << " s, " << static_cast<long long>(r.cardsPerSecond()) << " cards/s.\n";
+            for (const auto &f : r.failures)
+                cout << "Failed: " << f.first << " (" << f.second << ")\n";
+
+            pause();
+        }
+
+        // ------------------------ CLASS SUMMARIES ------------------------
+        else if (choice == 12)
+        {
+            // Maintained running totals: no scan of the student list
+            for (const string &className : mgr.getClassNames())
+                printSummary("Class " + className, mgr.getClassSummary(className));
+            printSummary("School", mgr.getSchoolSummary());
+
+            pause();
+        }
+
+        // ------------------------ STATISTICS ------------------------
+        else if (choice == 13)
+        {
+            cout << Metrics::toText();
+            string path = readLine("Prometheus file to write (blank to skip): ");
+            if (!path.empty())
+            {
+                if (Metrics::writePrometheus(path))
+                    cout << "Written to " << path << "\n";
+                else
+                    cout << "Failed to write " << path << "\n";
+            }
+
+            pause();
+        }
+
         // ------------------------ INVALID OPTION ------------------------
         else
         {
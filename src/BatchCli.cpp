@@ -0,0 +1,613 @@
+#include "BatchCli.h"
+#include "DiskIndex.h"
+#include "MappedFile.h"
+#include "Metrics.h"
+#include "StudentCursor.h"
+#include "StudentManager.h"
+#include <fstream>
+#include <iomanip>
+#include <charconv>
+#include <cstdlib>
+#include <memory>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    // State shared by the commands of one run: the manager is loaded once, and mutations
+    // collect in `pending` until a read command or the end of the run commits them.
+    struct CliContext
+    {
+        StudentManager &mgr;
+        ostream &out;
+        ostream &err;
+        StudentBatch pending;
+    };
+
+    static void printUsage(ostream &err)
+    {
+        err << "Usage: reportcard [--data FILE] [--threads N] [--metrics FILE] COMMAND [ARGS]\n"
+               "Commands:\n"
+               "  import FILE                  add every student in FILE (CSV) as one batch\n"
+               "  export DIR [--max-open N]    write DIR/<class>/<roll>.txt report cards\n"
+               "  query --class NAME           print report cards of a class\n"
+               "  query --roll N               print the report card of a roll number\n"
+               "  topk K [--class NAME]        list the K best students\n"
+               "  rank [K]                     school ranking with competition and dense ranks\n"
+               "  regrade                      recompute results from marks and save\n"
+               "  stats                        operation counts, latencies and I/O so far\n"
+               "  scan [--class NAME] [--passed | --failed] [--min P] [--max P] [--by-class] [--list]\n"
+               "                               stream the data file without loading it and\n"
+               "                               summarise (or list) the matching records\n"
+               "  index                        build DATA.idx for lookups without loading\n"
+               "  lookup --roll N | --class NAME [--roll N]\n"
+               "                               report cards found through DATA.idx (built\n"
+               "                               first if missing or out of date)\n"
+               "  run FILE                     run commands from FILE, one per line\n"
+               "Commands accepted in a run file (and on the command line):\n"
+               "  add NAME CLASS ROLL MARKS [COMMENT]   MARKS like 90;85;77\n"
+               "  marks ROLL MARKS\n"
+               "  comment ROLL TEXT\n"
+               "  remove ROLL\n"
+               "Mutations are committed together with a single write.\n"
+               "--metrics FILE writes the statistics in Prometheus text format when the run ends.\n";
+    }
+
+    // Split a command line on blanks; "double quotes" group words, '#' starts a comment.
+    static vector<string> tokenize(const string &line)
+    {
+        vector<string> tokens;
+        string cur;
+        bool inQuotes = false;
+        bool inToken = false;
+        for (char c : line)
+        {
+            if (c == '"')
+            {
+                inQuotes = !inQuotes;
+                inToken = true;
+            }
+            else if (!inQuotes && c == '#')
+            {
+                break;
+            }
+            else if (!inQuotes && (c == ' ' || c == '\t' || c == '\r'))
+            {
+                if (inToken)
+                    tokens.push_back(cur);
+                cur.clear();
+                inToken = false;
+            }
+            else
+            {
+                cur.push_back(c);
+                inToken = true;
+            }
+        }
+        if (inToken)
+            tokens.push_back(cur);
+        return tokens;
+    }
+
+    static bool parseNumber(const string &text, long long &value)
+    {
+        auto res = from_chars(text.data(), text.data() + text.size(), value);
+        return res.ec == errc() && res.ptr == text.data() + text.size();
+    }
+
+    static bool parseInt(const string &text, int &value)
+    {
+        long long v;
+        if (!parseNumber(text, v) || v < INT32_MIN || v > INT32_MAX)
+            return false;
+        value = static_cast<int>(v);
+        return true;
+    }
+
+    // "72.5" -> 72.5; the whole text must be a number in 0..100.
+    static bool parsePercentage(const string &text, double &value)
+    {
+        char *end = nullptr;
+        value = strtod(text.c_str(), &end);
+        return !text.empty() && end == text.c_str() + text.size() && value >= 0.0 && value <= 100.0;
+    }
+
+    // "90;85;77" -> {90, 85, 77}; every mark must be 0..100 (same rule as RCUtils::readMark).
+    static bool parseMarks(const string &text, vector<int> &marks)
+    {
+        marks.clear();
+        if (text.empty())
+            return true;
+        size_t pos = 0;
+        while (pos <= text.size())
+        {
+            size_t semi = text.find(';', pos);
+            if (semi == string::npos)
+                semi = text.size();
+            int m;
+            if (!parseInt(text.substr(pos, semi - pos), m) || m < 0 || m > 100)
+                return false;
+            marks.push_back(m);
+            pos = semi + 1;
+        }
+        return true;
+    }
+
+    // Commit the collected mutations, if any. Returns an exit code.
+    static int flushPending(CliContext &ctx)
+    {
+        if (ctx.pending.empty())
+            return 0;
+        size_t count = ctx.pending.size();
+        BatchResult r = ctx.mgr.commitBatch(ctx.pending);
+        ctx.pending.clear();
+        if (!r.committed)
+        {
+            ctx.err << "Batch of " << count << " changes not applied: " << r.rejected << " rejected";
+            for (size_t i : r.rejectedIndexes)
+                ctx.err << " #" << (i + 1);
+            ctx.err << (r.rejected ? "\n" : " (write failed)\n");
+            return 1;
+        }
+        ctx.out << "Applied " << r.applied << " changes.\n";
+        return 0;
+    }
+
+    static int cmdImport(CliContext &ctx, const vector<string> &args)
+    {
+        if (args.size() != 2)
+            return 2;
+        MappedFile file(args[1]);
+        if (!file.isOpen())
+        {
+            ctx.err << "Cannot open " << args[1] << "\n";
+            return 1;
+        }
+        string_view text = file.view();
+        size_t pos = 0, lineNo = 0, bad = 0;
+        while (pos < text.size())
+        {
+            size_t nl = text.find('\n', pos);
+            if (nl == string_view::npos)
+                nl = text.size();
+            string_view line = text.substr(pos, nl - pos);
+            pos = nl + 1;
+            ++lineNo;
+            // a file saved by a Windows tool ends lines in "\r\n"; the '\r' is not part of the record
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                continue;
+            Student s;
+            if (Student::fromCSV(line, s))
+                ctx.pending.addStudent(s);
+            else
+            {
+                ctx.err << args[1] << ":" << lineNo << ": not a student record\n";
+                ++bad;
+            }
+        }
+        if (bad)
+        {
+            ctx.pending.clear();
+            return 1;
+        }
+        return flushPending(ctx);
+    }
+
+    static int cmdExport(CliContext &ctx, const vector<string> &args, unsigned threads)
+    {
+        if (args.size() != 2 && args.size() != 4)
+            return 2;
+        int maxOpen = 64;
+        if (args.size() == 4 && (args[2] != "--max-open" || !parseInt(args[3], maxOpen) || maxOpen < 1))
+            return 2;
+        ExportResult r = ctx.mgr.exportReportCards(args[1], threads, static_cast<unsigned>(maxOpen));
+        ctx.out << "Exported " << r.written << " report cards (" << r.bytes << " bytes) in " << r.seconds
+                << " s, " << static_cast<long long>(r.cardsPerSecond()) << " cards/s.\n";
+        for (const auto &f : r.failures)
+            ctx.err << "Failed: " << f.first << " (" << f.second << ")\n";
+        return r.failures.empty() ? 0 : 1;
+    }
+
+    static int cmdQuery(CliContext &ctx, const vector<string> &args)
+    {
+        if (args.size() != 3)
+            return 2;
+        string buf;
+        if (args[1] == "--class")
+        {
+            for (const auto &s : ctx.mgr.getClassView(args[2]))
+                s.appendReportCard(buf);
+        }
+        else if (args[1] == "--roll")
+        {
+            int roll;
+            if (!parseInt(args[2], roll))
+                return 2;
+            if (const Student *s = ctx.mgr.findByRoll(roll))
+                s->appendReportCard(buf);
+        }
+        else
+        {
+            return 2;
+        }
+        if (buf.empty())
+        {
+            ctx.err << "No matching students.\n";
+            return 1;
+        }
+        ctx.out << buf;
+        return 0;
+    }
+
+    static int cmdTopK(CliContext &ctx, const vector<string> &args)
+    {
+        int k;
+        if ((args.size() != 2 && args.size() != 4) || !parseInt(args[1], k) || k < 0)
+            return 2;
+        if (args.size() == 4 && args[2] != "--class")
+            return 2;
+        vector<const Student *> top = args.size() == 4 ? ctx.mgr.topKByClass(args[3], k) : ctx.mgr.topK(k);
+        ctx.out << fixed << setprecision(2);
+        for (size_t i = 0; i < top.size(); ++i)
+        {
+            const Student &s = *top[i];
+            ctx.out << (i + 1) << ". " << s.getName() << " (" << s.getClassName() << ", roll " << s.getRoll()
+                    << ") " << s.getPercentage() << "% " << s.getGrade() << "\n";
+        }
+        return 0;
+    }
+
+    static int cmdRank(CliContext &ctx, const vector<string> &args, unsigned threads)
+    {
+        int k = -1;
+        if (args.size() > 2 || (args.size() == 2 && (!parseInt(args[1], k) || k < 0)))
+            return 2;
+        vector<RankedStudent> ranked = ctx.mgr.ranking(threads);
+        size_t shown = k < 0 ? ranked.size() : min(ranked.size(), static_cast<size_t>(k));
+        ctx.out << fixed << setprecision(2);
+        for (size_t i = 0; i < shown; ++i)
+        {
+            const Student &s = *ranked[i].student;
+            ctx.out << ranked[i].competitionRank << " (dense " << ranked[i].denseRank << ") " << s.getName() << " ("
+                    << s.getClassName() << ", roll " << s.getRoll() << ") " << s.getPercentage() << "% "
+                    << s.getGrade() << "\n";
+        }
+        return 0;
+    }
+
+    static int cmdRegrade(CliContext &ctx, const vector<string> &args)
+    {
+        if (args.size() != 1)
+            return 2;
+        size_t changed = ctx.mgr.regradeAll();
+        ctx.out << "Regraded " << ctx.mgr.getAll().size() << " students, " << changed << " changed.\n";
+        if (changed > 0 && !ctx.mgr.saveToFile())
+        {
+            ctx.err << "Failed to save.\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Record a mutation in ctx.pending. Returns an exit code (2 = malformed).
+    static int queueMutation(CliContext &ctx, const vector<string> &args)
+    {
+        const string &cmd = args[0];
+        int roll;
+        vector<int> marks;
+        if (cmd == "add" && (args.size() == 5 || args.size() == 6) && parseInt(args[3], roll) &&
+            parseMarks(args[4], marks))
+        {
+            Student s(args[1], args[2], roll, marks);
+            if (args.size() == 6)
+                s.setTeacherComment(args[5]);
+            ctx.pending.addStudent(s);
+            return 0;
+        }
+        if (cmd == "marks" && args.size() == 3 && parseInt(args[1], roll) && parseMarks(args[2], marks))
+        {
+            ctx.pending.editMarks(roll, marks);
+            return 0;
+        }
+        if (cmd == "comment" && args.size() >= 2 && parseInt(args[1], roll))
+        {
+            string text;
+            for (size_t i = 2; i < args.size(); ++i)
+                text += (i > 2 ? " " : "") + args[i];
+            ctx.pending.editTeacherComment(roll, text);
+            return 0;
+        }
+        if (cmd == "remove" && args.size() == 2 && parseInt(args[1], roll))
+        {
+            ctx.pending.removeByRoll(roll);
+            return 0;
+        }
+        return 2;
+    }
+
+    static int cmdStats(CliContext &ctx, const vector<string> &args)
+    {
+        if (args.size() != 1)
+            return 2;
+        ctx.out << Metrics::toText();
+        return 0;
+    }
+
+    static void printScanSummary(ostream &out, const string &label, const ClassSummary &s)
+    {
+        out << label << ": " << s.count << " students";
+        if (s.count > 0)
+            out << ", average " << s.averagePercentage() << "%, min " << s.minPercentage << "%, max "
+                << s.maxPercentage << "%, pass " << s.passCount << " (" << 100.0 * s.passRate() << "%)";
+        out << "\n";
+    }
+
+    // Runs before (instead of) the StudentManager load: the point is to handle files that
+    // do not fit in memory.
+    static int cmdScan(const string &dataFile, const vector<string> &args, ostream &out, ostream &err)
+    {
+        ScanFilter filter;
+        bool list = false, byClass = false;
+        for (size_t i = 1; i < args.size(); ++i)
+        {
+            const string &opt = args[i];
+            bool hasValue = i + 1 < args.size();
+            if (opt == "--class" && hasValue)
+                filter.className = args[++i];
+            else if (opt == "--passed")
+                filter.result = ScanFilter::Result::Passed;
+            else if (opt == "--failed")
+                filter.result = ScanFilter::Result::Failed;
+            else if (opt == "--min" && hasValue && parsePercentage(args[i + 1], filter.minPercentage))
+                ++i;
+            else if (opt == "--max" && hasValue && parsePercentage(args[i + 1], filter.maxPercentage))
+                ++i;
+            else if (opt == "--list")
+                list = true;
+            else if (opt == "--by-class")
+                byClass = true;
+            else
+                return 2;
+        }
+
+        out << fixed << setprecision(2);
+        if (list)
+        {
+            StudentCursor cursor(dataFile, filter);
+            if (!cursor.isOpen())
+            {
+                err << "Cannot open " << dataFile << "\n";
+                return 1;
+            }
+            while (cursor.next())
+            {
+                const Student &s = cursor.current();
+                out << s.getName() << " (" << s.getClassName() << ", roll " << s.getRoll() << ") "
+                    << s.getPercentage() << "% " << s.getGrade() << "\n";
+            }
+            if (cursor.parseFailures() > 0)
+                err << cursor.parseFailures() << " unreadable lines skipped.\n";
+            return 0;
+        }
+
+        ScanSummary summary;
+        if (!scanSummaries(dataFile, filter, summary))
+        {
+            err << "Cannot open " << dataFile << "\n";
+            return 1;
+        }
+        if (byClass)
+        {
+            for (const auto &entry : summary.byClass)
+                printScanSummary(out, "Class " + entry.first, entry.second);
+        }
+        printScanSummary(out, "Matched", summary.all);
+        out << "Scanned " << summary.recordsRead << " records";
+        if (summary.parseFailures > 0)
+            out << ", skipped " << summary.parseFailures << " unreadable lines";
+        out << ".\n";
+        return 0;
+    }
+
+    static int cmdIndex(const string &dataFile, const vector<string> &args, ostream &out, ostream &err)
+    {
+        if (args.size() != 1)
+            return 2;
+        if (!DiskIndex::build(dataFile))
+        {
+            err << "Cannot index " << dataFile << "\n";
+            return 1;
+        }
+        out << "Indexed " << DiskIndex(dataFile).size() << " records into " << DiskIndex::pathFor(dataFile) << "\n";
+        return 0;
+    }
+
+    // Like query, but through the on-disk index instead of a full load.
+    static int cmdLookup(const string &dataFile, const vector<string> &args, ostream &out, ostream &err)
+    {
+        string className;
+        int roll = 0;
+        bool haveRoll = false;
+        for (size_t i = 1; i + 1 < args.size(); i += 2)
+        {
+            if (args[i] == "--class")
+                className = args[i + 1];
+            else if (args[i] == "--roll" && parseInt(args[i + 1], roll))
+                haveRoll = true;
+            else
+                return 2;
+        }
+        if (args.size() % 2 == 0 || (className.empty() && !haveRoll))
+            return 2;
+
+        auto index = make_unique<DiskIndex>(dataFile);
+        if (!index->isOpen())
+        {
+            err << "Building " << DiskIndex::pathFor(dataFile) << "...\n";
+            if (!DiskIndex::build(dataFile))
+            {
+                err << "Cannot index " << dataFile << "\n";
+                return 1;
+            }
+            index = make_unique<DiskIndex>(dataFile);
+        }
+
+        string buf;
+        Student s;
+        if (haveRoll)
+        {
+            bool found = className.empty() ? index->findByRoll(roll, s) : index->find(className, roll, s);
+            if (found)
+                s.appendReportCard(buf);
+        }
+        else
+        {
+            index->scanClass(className, [&buf](const Student &member)
+                             {
+                member.appendReportCard(buf);
+                return true; });
+        }
+        if (buf.empty())
+        {
+            err << "No matching students.\n";
+            return 1;
+        }
+        out << buf;
+        return 0;
+    }
+
+    static bool isMutation(const string &cmd)
+    {
+        return cmd == "add" || cmd == "marks" || cmd == "comment" || cmd == "remove";
+    }
+
+    static int dispatch(CliContext &ctx, const vector<string> &args, unsigned threads, bool nested);
+
+    static int cmdRun(CliContext &ctx, const vector<string> &args, unsigned threads)
+    {
+        if (args.size() != 2)
+            return 2;
+        ifstream ifs(args[1]);
+        if (!ifs.is_open())
+        {
+            ctx.err << "Cannot open " << args[1] << "\n";
+            return 1;
+        }
+        string line;
+        size_t lineNo = 0;
+        while (getline(ifs, line))
+        {
+            ++lineNo;
+            vector<string> tokens = tokenize(line);
+            if (tokens.empty())
+                continue;
+            int rc = dispatch(ctx, tokens, threads, true);
+            if (rc != 0)
+            {
+                ctx.pending.clear();
+                ctx.err << args[1] << ":" << lineNo << ": " << (rc == 2 ? "invalid command" : "command failed")
+                        << ": " << line << "\n";
+                return 1;
+            }
+        }
+        return flushPending(ctx);
+    }
+
+    static int dispatch(CliContext &ctx, const vector<string> &args, unsigned threads, bool nested)
+    {
+        const string &cmd = args[0];
+        if (isMutation(cmd))
+            return queueMutation(ctx, args);
+
+        // read commands see every change queued before them
+        if (int rc = flushPending(ctx))
+            return rc;
+
+        if (cmd == "import")
+            return cmdImport(ctx, args);
+        if (cmd == "export")
+            return cmdExport(ctx, args, threads);
+        if (cmd == "query")
+            return cmdQuery(ctx, args);
+        if (cmd == "topk")
+            return cmdTopK(ctx, args);
+        if (cmd == "rank")
+            return cmdRank(ctx, args, threads);
+        if (cmd == "regrade")
+            return cmdRegrade(ctx, args);
+        if (cmd == "stats")
+            return cmdStats(ctx, args);
+        if (cmd == "run" && !nested)
+            return cmdRun(ctx, args, threads);
+        return 2;
+    }
+
+    int runBatchCli(const vector<string> &args, const string &defaultDataFile, ostream &out, ostream &err)
+    {
+        string dataFile = defaultDataFile;
+        string metricsFile;
+        int threads = 0;
+        size_t i = 0;
+        for (; i < args.size() && args[i].compare(0, 2, "--") == 0; i += 2)
+        {
+            if (i + 1 >= args.size())
+            {
+                printUsage(err);
+                return 2;
+            }
+            if (args[i] == "--data")
+                dataFile = args[i + 1];
+            else if (args[i] == "--metrics")
+                metricsFile = args[i + 1];
+            else if (args[i] == "--threads" && parseInt(args[i + 1], threads) && threads >= 0)
+                continue;
+            else
+            {
+                printUsage(err);
+                return 2;
+            }
+        }
+        if (i >= args.size() || args[i] == "help")
+        {
+            printUsage(err);
+            return i >= args.size() ? 2 : 0;
+        }
+
+        // one-shot run: timing costs nothing noticeable and lets `stats` include the load
+        Metrics::setEnabled(true);
+        vector<string> command(args.begin() + i, args.end());
+        int rc;
+        // commands meant for files too large to load run without a StudentManager
+        if (args[i] == "scan" || args[i] == "index" || args[i] == "lookup")
+        {
+            rc = args[i] == "scan"    ? cmdScan(dataFile, command, out, err)
+                 : args[i] == "index" ? cmdIndex(dataFile, command, out, err)
+                                      : cmdLookup(dataFile, command, out, err);
+        }
+        else
+        {
+            StudentManager mgr(dataFile, static_cast<unsigned>(threads)); // the only load of this run
+            mgr.setSnapshotMirroring(true);
+            // keep an index someone built current; never create one unasked
+            mgr.setDiskIndex(ifstream(DiskIndex::pathFor(dataFile)).good());
+
+            CliContext ctx{mgr, out, err, StudentBatch()};
+            rc = dispatch(ctx, command, static_cast<unsigned>(threads), false);
+            if (rc == 0)
+                rc = flushPending(ctx);
+        }
+        if (rc == 2)
+            printUsage(err);
+        if (!metricsFile.empty() && !Metrics::writePrometheus(metricsFile))
+        {
+            err << "Cannot write " << metricsFile << "\n";
+            if (rc == 0)
+                rc = 1;
+        }
+        return rc;
+    }
+
+} // namespace ReportCard
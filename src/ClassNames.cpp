@@ -0,0 +1,84 @@
+#include "ClassNames.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    namespace
+    {
+        struct Registry
+        {
+            shared_mutex lock; // shared for lookups, exclusive only to add a name
+            deque<ClassName> entries;                              // stable addresses
+            unordered_map<string_view, const ClassName *> lookup; // keys view entries' text
+        };
+
+        Registry &registry()
+        {
+            static Registry r;
+            return r;
+        }
+    }
+
+    const ClassName &ClassNames::intern(string_view name)
+    {
+        // loads and imports usually see the same class many times in a row
+        thread_local const ClassName *last = nullptr;
+        if (last && last->text == name)
+            return *last;
+
+        Registry &r = registry();
+        {
+            shared_lock<shared_mutex> reader(r.lock);
+            auto it = r.lookup.find(name);
+            if (it != r.lookup.end())
+            {
+                last = it->second;
+                return *last;
+            }
+        }
+
+        // another thread may have added the name between the two locks
+        unique_lock<shared_mutex> writer(r.lock);
+        auto it = r.lookup.find(name);
+        if (it == r.lookup.end())
+        {
+            r.entries.push_back(ClassName{string(name), static_cast<uint32_t>(r.entries.size())});
+            const ClassName *entry = &r.entries.back();
+            it = r.lookup.emplace(string_view(entry->text), entry).first;
+        }
+        last = it->second;
+        return *last;
+    }
+
+    bool ClassNames::find(string_view name, uint32_t &outId)
+    {
+        Registry &r = registry();
+        shared_lock<shared_mutex> guard(r.lock);
+        auto it = r.lookup.find(name);
+        if (it == r.lookup.end())
+            return false;
+        outId = it->second->id;
+        return true;
+    }
+
+    const ClassName &ClassNames::byId(uint32_t id)
+    {
+        Registry &r = registry();
+        shared_lock<shared_mutex> guard(r.lock);
+        return r.entries[id];
+    }
+
+    size_t ClassNames::count()
+    {
+        Registry &r = registry();
+        shared_lock<shared_mutex> guard(r.lock);
+        return r.entries.size();
+    }
+
+} // namespace ReportCard
@@ -0,0 +1,166 @@
+#include "ConcurrentStudentManager.h"
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    ConcurrentStudentManager::ConcurrentStudentManager(const string &filename, unsigned loadThreads)
+        : manager_(filename, loadThreads)
+    {
+    }
+
+    // Readers only touch the gate while a writer is waiting or writing, so the common path is
+    // one atomic load plus the shared lock.
+    static shared_lock<shared_mutex> lockShared(shared_mutex &rw, mutex &gate,
+                                                const atomic<unsigned> &writersWaiting)
+    {
+        if (writersWaiting.load(memory_order_acquire) != 0)
+            lock_guard<mutex> wait(gate);
+        return shared_lock<shared_mutex>(rw);
+    }
+
+    ConcurrentStudentManager::ReadLock::ReadLock(const ConcurrentStudentManager &owner)
+        : lock_(lockShared(owner.mutex_, owner.gate_, owner.writersWaiting_))
+    {
+    }
+
+    // writersWaiting_ is raised before the gate is taken, so readers arriving while a writer
+    // waits for the gate already queue behind it; it drops once the exclusive lock is held.
+    static mutex &announceWriter(mutex &gate, atomic<unsigned> &writersWaiting)
+    {
+        writersWaiting.fetch_add(1, memory_order_release);
+        return gate;
+    }
+
+    ConcurrentStudentManager::WriteLock::WriteLock(const ConcurrentStudentManager &owner)
+        : gate_(announceWriter(owner.gate_, owner.writersWaiting_)), lock_(owner.mutex_)
+    {
+        owner.writersWaiting_.fetch_sub(1, memory_order_release);
+    }
+
+    // --- Reads: copy out while the shared lock is held ---
+
+    optional<Student> ConcurrentStudentManager::findByRoll(int roll) const
+    {
+        ReadLock lock(*this);
+        const Student *s = static_cast<const StudentManager &>(manager_).findByRoll(roll);
+        return s ? optional<Student>(*s) : nullopt;
+    }
+
+    vector<Student> ConcurrentStudentManager::getStudentsByClass(const string &className) const
+    {
+        ReadLock lock(*this);
+        return manager_.getStudentsByClass(className);
+    }
+
+    optional<Student> ConcurrentStudentManager::getTopper() const
+    {
+        ReadLock lock(*this);
+        const Student *s = manager_.getTopper();
+        return s ? optional<Student>(*s) : nullopt;
+    }
+
+    vector<Student> ConcurrentStudentManager::topK(size_t k) const
+    {
+        ReadLock lock(*this);
+        vector<Student> result;
+        for (const Student *s : manager_.topK(k))
+            result.push_back(*s);
+        return result;
+    }
+
+    size_t ConcurrentStudentManager::rankOf(int roll) const
+    {
+        ReadLock lock(*this);
+        return manager_.rankOf(roll);
+    }
+
+    ClassSummary ConcurrentStudentManager::getClassSummary(const string &className) const
+    {
+        ReadLock lock(*this);
+        return manager_.getClassSummary(className);
+    }
+
+    ClassSummary ConcurrentStudentManager::getSchoolSummary() const
+    {
+        ReadLock lock(*this);
+        return manager_.getSchoolSummary();
+    }
+
+    bool ConcurrentStudentManager::rollExists(int roll) const
+    {
+        ReadLock lock(*this);
+        return manager_.rollExists(roll);
+    }
+
+    size_t ConcurrentStudentManager::size() const
+    {
+        ReadLock lock(*this);
+        return manager_.getAll().size();
+    }
+
+    // --- Writes: exclusive ---
+
+    bool ConcurrentStudentManager::addStudent(const Student &s)
+    {
+        WriteLock lock(*this);
+        return manager_.addStudent(s);
+    }
+
+    bool ConcurrentStudentManager::editMarks(int roll, const vector<int> &newMarks)
+    {
+        WriteLock lock(*this);
+        return manager_.editMarks(roll, newMarks);
+    }
+
+    bool ConcurrentStudentManager::editMark(int roll, size_t subject, int mark)
+    {
+        WriteLock lock(*this);
+        return manager_.editMark(roll, subject, mark);
+    }
+
+    bool ConcurrentStudentManager::editTeacherComment(int roll, const string &comment)
+    {
+        WriteLock lock(*this);
+        return manager_.editTeacherComment(roll, comment);
+    }
+
+    bool ConcurrentStudentManager::removeByRoll(int roll)
+    {
+        WriteLock lock(*this);
+        return manager_.removeByRoll(roll);
+    }
+
+    void ConcurrentStudentManager::sortByPercentageDesc()
+    {
+        WriteLock lock(*this);
+        manager_.sortByPercentageDesc();
+    }
+
+    BatchResult ConcurrentStudentManager::commitBatch(const StudentBatch &batch)
+    {
+        WriteLock lock(*this);
+        return manager_.commitBatch(batch);
+    }
+
+    bool ConcurrentStudentManager::saveToFile()
+    {
+        // saveToFile() is const but resets the journal bookkeeping, so it must not overlap readers
+        WriteLock lock(*this);
+        return manager_.saveToFile();
+    }
+
+    bool ConcurrentStudentManager::checkpoint()
+    {
+        WriteLock lock(*this);
+        return manager_.checkpoint();
+    }
+
+    void ConcurrentStudentManager::setJournaling(bool enabled)
+    {
+        WriteLock lock(*this);
+        manager_.setJournaling(enabled);
+    }
+
+} // namespace ReportCard
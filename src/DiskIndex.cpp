@@ -0,0 +1,291 @@
+#include "DiskIndex.h"
+#include "BinaryIO.h"
+#include "ClassNames.h"
+#include "FileIO.h"
+#include "Metrics.h"
+#include "StudentCursor.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <tuple>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    // Index layout (little-endian):
+    //   magic[8] "RCIDX\0\0\1", u32 version, u32 flags, u64 csvSize, u64 csvMtime,
+    //   u64 classCount, u64 entryCount,
+    //   classCount x length-prefixed class name (sorted),
+    //   entryCount x {u32 class ordinal, i32 roll, u64 offset, u32 length} sorted by
+    //     (class, roll, offset),
+    //   entryCount x u32 entry number sorted by (roll, offset).
+    static const char kIndexMagic[8] = {'R', 'C', 'I', 'D', 'X', '\0', '\0', '\1'};
+    static const uint32_t kIndexVersion = 1;
+    static const size_t kHeaderBytes = sizeof kIndexMagic + 4 + 4 + 8 + 8 + 8 + 8;
+    static const size_t kEntryBytes = 4 + 4 + 8 + 4;
+    static const size_t kFlushBytes = 1 << 20;
+
+    static uint32_t loadU32(const char *p)
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i)
+            v |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+        return v;
+    }
+
+    static uint64_t loadU64(const char *p)
+    {
+        return static_cast<uint64_t>(loadU32(p)) | (static_cast<uint64_t>(loadU32(p + 4)) << 32);
+    }
+
+    string DiskIndex::pathFor(const string &dataFile)
+    {
+        return dataFile + ".idx";
+    }
+
+    bool DiskIndex::write(const string &dataFile, vector<IndexEntry> &entries)
+    {
+        uint64_t csvSize, csvMtime;
+        if (!fileIdentity(dataFile, csvSize, csvMtime))
+            return false;
+
+        // class ids -> ordinals in name order, so each class's entries end up contiguous
+        vector<uint32_t> ids;
+        for (const auto &e : entries)
+        {
+            if (e.classId >= ids.size())
+                ids.resize(e.classId + 1, UINT32_MAX);
+            ids[e.classId] = e.classId;
+        }
+        ids.erase(remove(ids.begin(), ids.end(), UINT32_MAX), ids.end());
+        sort(ids.begin(), ids.end(), [](uint32_t a, uint32_t b)
+             { return ClassNames::byId(a).text < ClassNames::byId(b).text; });
+        vector<uint32_t> ordinal(ids.empty() ? 0 : *max_element(ids.begin(), ids.end()) + 1);
+        for (uint32_t i = 0; i < ids.size(); ++i)
+            ordinal[ids[i]] = i;
+        for (auto &e : entries)
+            e.classId = ordinal[e.classId];
+
+        sort(entries.begin(), entries.end(), [](const IndexEntry &a, const IndexEntry &b)
+             { return tie(a.classId, a.roll, a.offset) < tie(b.classId, b.roll, b.offset); });
+        vector<uint32_t> byRoll(entries.size());
+        iota(byRoll.begin(), byRoll.end(), 0u);
+        sort(byRoll.begin(), byRoll.end(), [&](uint32_t a, uint32_t b)
+             { return tie(entries[a].roll, entries[a].offset) < tie(entries[b].roll, entries[b].offset); });
+
+        string path = pathFor(dataFile), tmp = path + ".tmp";
+        ofstream ofs(tmp, ios::binary | ios::trunc);
+        if (!ofs.is_open())
+            return false;
+        string buf;
+        uint64_t written = 0;
+        auto flush = [&](bool force)
+        {
+            if (buf.size() >= kFlushBytes || force)
+            {
+                ofs.write(buf.data(), static_cast<streamsize>(buf.size()));
+                written += buf.size();
+                buf.clear();
+            }
+        };
+        buf.append(kIndexMagic, sizeof kIndexMagic);
+        putU32(buf, kIndexVersion);
+        putU32(buf, 0);
+        putU64(buf, csvSize);
+        putU64(buf, csvMtime);
+        putU64(buf, ids.size());
+        putU64(buf, entries.size());
+        for (uint32_t id : ids)
+            putString(buf, ClassNames::byId(id).text);
+        for (const auto &e : entries)
+        {
+            putU32(buf, e.classId);
+            putI32(buf, e.roll);
+            putU64(buf, e.offset);
+            putU32(buf, e.length);
+            flush(false);
+        }
+        for (uint32_t n : byRoll)
+        {
+            putU32(buf, n);
+            flush(false);
+        }
+        flush(true);
+        ofs.close();
+        if (!ofs)
+            return false;
+        Metrics::add(MetricCounter::BytesWritten, written);
+        return replaceWithTemp(tmp, path);
+    }
+
+    bool DiskIndex::build(const string &dataFile)
+    {
+        StudentCursor cursor(dataFile);
+        if (!cursor.isOpen())
+            return false;
+        vector<IndexEntry> entries;
+        while (cursor.next())
+        {
+            const Student &s = cursor.current();
+            entries.push_back(IndexEntry{s.getClassId(), s.getRoll(), cursor.currentOffset(),
+                                         static_cast<uint32_t>(cursor.currentLength())});
+        }
+        return write(dataFile, entries);
+    }
+
+    DiskIndex::DiskIndex(const string &dataFile)
+        : map_(make_unique<MappedFile>(pathFor(dataFile))), data_(dataFile, ios::binary)
+    {
+        const MappedFile &file = *map_;
+        uint64_t csvSize, csvMtime;
+        if (!file.isOpen() || !data_.is_open() || file.size() < kHeaderBytes ||
+            memcmp(file.data(), kIndexMagic, sizeof kIndexMagic) != 0 ||
+            !fileIdentity(dataFile, csvSize, csvMtime))
+            return;
+
+        BinaryReader in(file.data() + sizeof kIndexMagic, file.data() + file.size());
+        uint32_t version, flags;
+        uint64_t idxSize, idxMtime, classCount;
+        if (!in.getU32(version) || !in.getU32(flags) || !in.getU64(idxSize) || !in.getU64(idxMtime) ||
+            !in.getU64(classCount) || !in.getU64(count_) || version != kIndexVersion ||
+            idxSize != csvSize || idxMtime != csvMtime)
+            return; // missing, foreign or stale: the CSV changed since the index was written
+
+        classes_.reserve(static_cast<size_t>(min<uint64_t>(classCount, file.size())));
+        for (uint64_t i = 0; i < classCount; ++i)
+        {
+            string name;
+            if (!in.getString(name))
+                return;
+            classes_.push_back(move(name));
+        }
+
+        // the rest is exactly the two fixed-width sections
+        size_t rest = static_cast<size_t>(file.data() + file.size() - in.position());
+        if (rest % (kEntryBytes + 4) != 0 || rest / (kEntryBytes + 4) != count_)
+            return;
+        entries_ = in.position();
+        rollOrder_ = entries_ + count_ * kEntryBytes;
+        open_ = true;
+    }
+
+    bool DiskIndex::isOpen() const
+    {
+        return open_;
+    }
+
+    size_t DiskIndex::size() const
+    {
+        return open_ ? static_cast<size_t>(count_) : 0;
+    }
+
+    IndexEntry DiskIndex::entryAt(uint64_t i) const
+    {
+        const char *p = entries_ + i * kEntryBytes;
+        return IndexEntry{loadU32(p), static_cast<int32_t>(loadU32(p + 4)), loadU64(p + 8), loadU32(p + 16)};
+    }
+
+    uint32_t DiskIndex::rollOrderAt(uint64_t i) const
+    {
+        return loadU32(rollOrder_ + i * 4);
+    }
+
+    bool DiskIndex::classOrdinal(const string &className, uint32_t &ordinal) const
+    {
+        auto it = lower_bound(classes_.begin(), classes_.end(), className);
+        if (it == classes_.end() || *it != className)
+            return false;
+        ordinal = static_cast<uint32_t>(it - classes_.begin());
+        return true;
+    }
+
+    bool DiskIndex::readRecord(const IndexEntry &entry, Student &out)
+    {
+        line_.resize(entry.length);
+        data_.clear();
+        data_.seekg(static_cast<streamoff>(entry.offset));
+        data_.read(&line_[0], static_cast<streamsize>(entry.length));
+        if (!data_)
+            return false;
+        Metrics::add(MetricCounter::BytesRead, entry.length);
+        return Student::fromCSV(line_, out);
+    }
+
+    bool DiskIndex::findByRoll(int roll, Student &out)
+    {
+        if (!open_)
+            return false;
+        Metrics::Timer timer(MetricOp::Lookup);
+        // first position in roll order whose roll is >= roll
+        uint64_t lo = 0, hi = count_;
+        while (lo < hi)
+        {
+            uint64_t mid = lo + (hi - lo) / 2;
+            if (entryAt(rollOrderAt(mid)).roll < roll)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == count_)
+            return false;
+        IndexEntry e = entryAt(rollOrderAt(lo));
+        return e.roll == roll && readRecord(e, out);
+    }
+
+    bool DiskIndex::find(const string &className, int roll, Student &out)
+    {
+        uint32_t ordinal;
+        if (!open_ || !classOrdinal(className, ordinal))
+            return false;
+        Metrics::Timer timer(MetricOp::Lookup);
+        uint64_t lo = 0, hi = count_;
+        while (lo < hi)
+        {
+            uint64_t mid = lo + (hi - lo) / 2;
+            IndexEntry e = entryAt(mid);
+            if (tie(e.classId, e.roll) < tie(ordinal, roll))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo == count_)
+            return false;
+        IndexEntry e = entryAt(lo);
+        return e.classId == ordinal && e.roll == roll && readRecord(e, out);
+    }
+
+    size_t DiskIndex::scanClass(const string &className, const function<bool(const Student &)> &visit)
+    {
+        uint32_t ordinal;
+        if (!open_ || !classOrdinal(className, ordinal))
+            return 0;
+        Metrics::Timer timer(MetricOp::ClassQuery);
+        uint64_t lo = 0, hi = count_;
+        while (lo < hi)
+        {
+            uint64_t mid = lo + (hi - lo) / 2;
+            if (entryAt(mid).classId < ordinal)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        Student s;
+        size_t visited = 0;
+        for (uint64_t i = lo; i < count_; ++i)
+        {
+            IndexEntry e = entryAt(i);
+            if (e.classId != ordinal)
+                break;
+            if (!readRecord(e, s))
+                continue;
+            ++visited;
+            if (!visit(s))
+                break;
+        }
+        return visited;
+    }
+
+} // namespace ReportCard
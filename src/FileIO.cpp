@@ -0,0 +1,36 @@
+#include "FileIO.h"
+#include <cstdio> // rename, remove
+#include <filesystem>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    bool fileIdentity(const string &path, uint64_t &size, uint64_t &mtime)
+    {
+        error_code ec;
+        uintmax_t sz = filesystem::file_size(path, ec);
+        if (ec)
+            return false;
+        auto t = filesystem::last_write_time(path, ec);
+        if (ec)
+            return false;
+        size = sz;
+        mtime = static_cast<uint64_t>(t.time_since_epoch().count());
+        return true;
+    }
+
+    bool replaceWithTemp(const string &tmp, const string &path)
+    {
+        if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            // attempt fallback: remove original and rename again
+            std::remove(path.c_str());
+            if (std::rename(tmp.c_str(), path.c_str()) != 0)
+                return false;
+        }
+        return true;
+    }
+
+} // namespace ReportCard
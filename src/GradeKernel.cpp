@@ -0,0 +1,130 @@
+#include "GradeKernel.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RC_HAVE_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    // Same expressions as Student::recalculate(); keep the two in sync.
+    static inline void gradeOne(const int *m, size_t count, int &total, double &percentage,
+                                Grade &grade, uint8_t &pass)
+    {
+        int t = 0;
+        for (size_t i = 0; i < count; ++i)
+            t += m[i];
+        int maxTotal = static_cast<int>(count) * 100;
+        double p = maxTotal > 0 ? (100.0 * t) / maxTotal : 0.0;
+        total = t;
+        percentage = p;
+        grade = gradeForPercentage(p);
+        pass = p >= 35.0 ? 1 : 0;
+    }
+
+    void gradeRowsScalar(const int *marks, const size_t *offsets, size_t rows,
+                         int *totals, double *percentages, Grade *grades, uint8_t *pass)
+    {
+        for (size_t r = 0; r < rows; ++r)
+            gradeOne(marks + offsets[r], offsets[r + 1] - offsets[r], totals[r], percentages[r],
+                     grades[r], pass[r]);
+    }
+
+#ifdef RC_HAVE_AVX2_KERNEL
+    static const size_t kMaxSimdWidth = 1 << 20;
+
+    // Grade 8 consecutive rows of `width` marks each, starting at m (row-major).
+    __attribute__((target("avx2"))) static void gradeBlock8(const int *m, int width, int *totals,
+                                                            double *percentages, Grade *grades,
+                                                            uint8_t *pass)
+    {
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i idx = _mm256_mullo_epi32(lane, _mm256_set1_epi32(width));
+        __m256i acc = _mm256_setzero_si256();
+        for (int c = 0; c < width; ++c)
+        {
+            acc = _mm256_add_epi32(acc, _mm256_i32gather_epi32(m + c, idx, 4));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(totals), acc);
+
+        const __m256d hundred = _mm256_set1_pd(100.0);
+        const __m256d maxTotal = _mm256_set1_pd(static_cast<double>(width * 100));
+        const double thresholds[5] = {90, 80, 70, 60, 50};
+        for (int half = 0; half < 2; ++half)
+        {
+            __m128i t4 = half ? _mm256_extracti128_si256(acc, 1) : _mm256_castsi256_si128(acc);
+            // (100.0 * total) / maxTotal, the same two IEEE operations as the scalar code
+            __m256d p = _mm256_div_pd(_mm256_mul_pd(hundred, _mm256_cvtepi32_pd(t4)), maxTotal);
+            _mm256_storeu_pd(percentages + 4 * half, p);
+
+            // brackets are nested, so the grade is F minus the number of thresholds reached
+            int reached[4] = {0, 0, 0, 0};
+            for (double th : thresholds)
+            {
+                int mask = _mm256_movemask_pd(_mm256_cmp_pd(p, _mm256_set1_pd(th), _CMP_GE_OQ));
+                for (int l = 0; l < 4; ++l)
+                    reached[l] += (mask >> l) & 1;
+            }
+            int passMask = _mm256_movemask_pd(_mm256_cmp_pd(p, _mm256_set1_pd(35.0), _CMP_GE_OQ));
+            for (int l = 0; l < 4; ++l)
+            {
+                grades[4 * half + l] = static_cast<Grade>(static_cast<int>(Grade::F) - reached[l]);
+                pass[4 * half + l] = static_cast<uint8_t>((passMask >> l) & 1);
+            }
+        }
+    }
+
+    __attribute__((target("avx2"))) static void gradeRowsAvx2(const int *marks, const size_t *offsets,
+                                                              size_t rows, int *totals,
+                                                              double *percentages, Grade *grades,
+                                                              uint8_t *pass)
+    {
+        size_t r = 0;
+        while (r < rows)
+        {
+            // find the run of rows sharing this row's subject count
+            size_t width = offsets[r + 1] - offsets[r];
+            size_t end = r + 1;
+            while (end < rows && offsets[end + 1] - offsets[end] == width)
+                ++end;
+
+            // gather indices and width * 100 must fit in an int
+            if (width > 0 && width <= kMaxSimdWidth)
+            {
+                for (; r + 8 <= end; r += 8)
+                    gradeBlock8(marks + offsets[r], static_cast<int>(width), totals + r,
+                                percentages + r, grades + r, pass + r);
+            }
+            for (; r < end; ++r)
+                gradeOne(marks + offsets[r], width, totals[r], percentages[r], grades[r], pass[r]);
+        }
+    }
+#endif
+
+    bool gradeKernelUsesSimd()
+    {
+#ifdef RC_HAVE_AVX2_KERNEL
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    void gradeRows(const int *marks, const size_t *offsets, size_t rows,
+                   int *totals, double *percentages, Grade *grades, uint8_t *pass)
+    {
+#ifdef RC_HAVE_AVX2_KERNEL
+        if (gradeKernelUsesSimd())
+        {
+            gradeRowsAvx2(marks, offsets, rows, totals, percentages, grades, pass);
+            return;
+        }
+#endif
+        gradeRowsScalar(marks, offsets, rows, totals, percentages, grades, pass);
+    }
+
+} // namespace ReportCard
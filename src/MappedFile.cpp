@@ -0,0 +1,73 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RC_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    MappedFile::MappedFile(const string &path)
+        : data_(nullptr), size_(0), open_(false), mapped_(false)
+    {
+#ifdef RC_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0)
+        {
+            open_ = true;
+            size_ = static_cast<size_t>(st.st_size);
+            if (size_ > 0)
+            {
+                void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED)
+                {
+                    data_ = static_cast<const char *>(p);
+                    mapped_ = true;
+                    ::madvise(p, size_, MADV_SEQUENTIAL); // hint only; failure is harmless
+                }
+                else
+                {
+                    open_ = false;
+                    size_ = 0;
+                }
+            }
+        }
+        ::close(fd); // the mapping stays valid after close
+#else
+        ifstream ifs(path, ios::binary);
+        if (!ifs.is_open())
+            return;
+        ostringstream oss;
+        oss << ifs.rdbuf();
+        buffer_ = oss.str();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        open_ = true;
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef RC_HAVE_MMAP
+        if (mapped_)
+            ::munmap(const_cast<char *>(data_), size_);
+#endif
+    }
+
+    bool MappedFile::isOpen() const { return open_; }
+    const char *MappedFile::data() const { return data_; }
+    size_t MappedFile::size() const { return size_; }
+    string_view MappedFile::view() const { return string_view(data_, size_); }
+
+} // namespace ReportCard
@@ -0,0 +1,213 @@
+#include "Metrics.h"
+#include "FileIO.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    static const size_t kOps = static_cast<size_t>(MetricOp::Count);
+    static const size_t kCounters = static_cast<size_t>(MetricCounter::Count);
+    static const size_t kBuckets = MetricsSnapshot::kBuckets;
+
+    struct OpCells
+    {
+        atomic<uint64_t> calls{0};
+        atomic<uint64_t> totalNs{0};
+        atomic<uint64_t> buckets[kBuckets] = {};
+    };
+
+    static OpCells opCells[kOps];
+    static atomic<uint64_t> counterCells[kCounters];
+
+    atomic<bool> Metrics::enabled_{false};
+
+    void Metrics::setEnabled(bool enabled)
+    {
+        enabled_.store(enabled, memory_order_relaxed);
+    }
+
+    void Metrics::record(MetricOp op, chrono::nanoseconds elapsed)
+    {
+        uint64_t ns = elapsed.count() > 0 ? static_cast<uint64_t>(elapsed.count()) : 0;
+        size_t bucket = 0;
+        while (bucket < MetricsSnapshot::kBucketBoundsNs.size() && ns > MetricsSnapshot::kBucketBoundsNs[bucket])
+            ++bucket;
+
+        OpCells &cells = opCells[static_cast<size_t>(op)];
+        cells.calls.fetch_add(1, memory_order_relaxed);
+        cells.totalNs.fetch_add(ns, memory_order_relaxed);
+        cells.buckets[bucket].fetch_add(1, memory_order_relaxed);
+    }
+
+    void Metrics::add(MetricCounter counter, uint64_t amount)
+    {
+        counterCells[static_cast<size_t>(counter)].fetch_add(amount, memory_order_relaxed);
+    }
+
+    MetricsSnapshot Metrics::snapshot()
+    {
+        MetricsSnapshot snap;
+        for (size_t i = 0; i < kOps; ++i)
+        {
+            snap.ops[i].calls = opCells[i].calls.load(memory_order_relaxed);
+            snap.ops[i].totalNs = opCells[i].totalNs.load(memory_order_relaxed);
+            for (size_t b = 0; b < kBuckets; ++b)
+                snap.ops[i].buckets[b] = opCells[i].buckets[b].load(memory_order_relaxed);
+        }
+        for (size_t i = 0; i < kCounters; ++i)
+            snap.counters[i] = counterCells[i].load(memory_order_relaxed);
+        return snap;
+    }
+
+    void Metrics::reset()
+    {
+        for (auto &cells : opCells)
+        {
+            cells.calls.store(0, memory_order_relaxed);
+            cells.totalNs.store(0, memory_order_relaxed);
+            for (auto &b : cells.buckets)
+                b.store(0, memory_order_relaxed);
+        }
+        for (auto &c : counterCells)
+            c.store(0, memory_order_relaxed);
+    }
+
+    const char *Metrics::name(MetricOp op)
+    {
+        static const char *const names[kOps] = {"load", "save", "journal_append", "lookup", "class_query", "sort"};
+        return names[static_cast<size_t>(op)];
+    }
+
+    const char *Metrics::name(MetricCounter counter)
+    {
+        static const char *const names[kCounters] = {"bytes_read", "bytes_written", "records_loaded",
+                                                     "parse_failures"};
+        return names[static_cast<size_t>(counter)];
+    }
+
+    uint64_t MetricsSnapshot::OpStats::quantileUpperNs(double q) const
+    {
+        if (calls == 0)
+            return 0;
+        // rank of the q-quantile among the recorded calls (1-based)
+        uint64_t rank = static_cast<uint64_t>(ceil(q * static_cast<double>(calls)));
+        if (rank < 1)
+            rank = 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kBucketBoundsNs.size(); ++b)
+        {
+            seen += buckets[b];
+            if (seen >= rank)
+                return kBucketBoundsNs[b];
+        }
+        return numeric_limits<uint64_t>::max();
+    }
+
+    string Metrics::toPrometheus()
+    {
+        MetricsSnapshot snap = snapshot();
+        ostringstream os;
+        os << "# HELP reportcard_operation_duration_seconds Latency of StudentManager operations.\n"
+              "# TYPE reportcard_operation_duration_seconds histogram\n";
+        for (size_t i = 0; i < kOps; ++i)
+        {
+            const auto &op = snap.ops[i];
+            const char *label = name(static_cast<MetricOp>(i));
+            uint64_t cumulative = 0;
+            for (size_t b = 0; b < kBuckets; ++b)
+            {
+                cumulative += op.buckets[b];
+                os << "reportcard_operation_duration_seconds_bucket{op=\"" << label << "\",le=\"";
+                if (b < MetricsSnapshot::kBucketBoundsNs.size())
+                    os << static_cast<double>(MetricsSnapshot::kBucketBoundsNs[b]) / 1e9;
+                else
+                    os << "+Inf";
+                os << "\"} " << cumulative << "\n";
+            }
+            os << "reportcard_operation_duration_seconds_sum{op=\"" << label << "\"} "
+               << static_cast<double>(op.totalNs) / 1e9 << "\n"
+               << "reportcard_operation_duration_seconds_count{op=\"" << label << "\"} " << op.calls << "\n";
+        }
+        for (size_t i = 0; i < kCounters; ++i)
+        {
+            const char *label = name(static_cast<MetricCounter>(i));
+            os << "# TYPE reportcard_" << label << "_total counter\n"
+               << "reportcard_" << label << "_total " << snap.counters[i] << "\n";
+        }
+        return os.str();
+    }
+
+    // Latency for toText(): "850ns", "12.30us", "4.56ms", "1.20s"; ">10.00s" for the +Inf bucket.
+    static string formatNs(double ns)
+    {
+        if (ns >= static_cast<double>(numeric_limits<uint64_t>::max()))
+            return ">" + formatNs(static_cast<double>(MetricsSnapshot::kBucketBoundsNs.back()));
+        static const char *const units[] = {"ns", "us", "ms", "s"};
+        size_t unit = 0;
+        while (unit < 3 && ns >= 1000.0)
+        {
+            ns /= 1000.0;
+            ++unit;
+        }
+        ostringstream os;
+        os.setf(ios::fixed);
+        os.precision(unit == 0 ? 0 : 2);
+        os << ns << units[unit];
+        return os.str();
+    }
+
+    string Metrics::toText()
+    {
+        MetricsSnapshot snap = snapshot();
+        ostringstream os;
+        os << left << setw(16) << "operation" << right << setw(12) << "calls" << setw(12) << "mean"
+           << setw(12) << "p50 <=" << setw(12) << "p99 <=" << "\n";
+        for (size_t i = 0; i < kOps; ++i)
+        {
+            const auto &op = snap.ops[i];
+            os << left << setw(16) << name(static_cast<MetricOp>(i)) << right << setw(12) << op.calls;
+            if (op.calls == 0)
+            {
+                os << setw(12) << "-" << setw(12) << "-" << setw(12) << "-" << "\n";
+                continue;
+            }
+            os << setw(12) << formatNs(static_cast<double>(op.totalNs) / static_cast<double>(op.calls))
+               << setw(12) << formatNs(static_cast<double>(op.quantileUpperNs(0.50)))
+               << setw(12) << formatNs(static_cast<double>(op.quantileUpperNs(0.99))) << "\n";
+        }
+        for (size_t i = 0; i < kCounters; ++i)
+            os << left << setw(16) << name(static_cast<MetricCounter>(i)) << right << setw(12) << snap.counters[i]
+               << "\n";
+        if (!enabled())
+            os << "(latency timing is off; counters are always kept)\n";
+        return os.str();
+    }
+
+    bool Metrics::writePrometheus(const string &path)
+    {
+        // write-then-rename so a scraper never reads a half-written file
+        string tmp = path + ".tmp";
+        {
+            ofstream ofs(tmp, ios::trunc);
+            if (!ofs.is_open())
+                return false;
+            ofs << toPrometheus();
+            if (!ofs)
+                return false;
+        }
+        if (!replaceWithTemp(tmp, path))
+        {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+} // namespace ReportCard
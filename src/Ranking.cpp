@@ -0,0 +1,115 @@
+#include "Ranking.h"
+#include "ClassNames.h"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    // Below this many rows per worker a parallel sort costs more in thread start-up than it saves.
+    static const size_t kMinRowsPerSortWorker = 1 << 16;
+
+    struct RankKey
+    {
+        double percentage;
+        int total;
+        uint32_t classOrdinal; // position of the class name in sorted order
+        int roll;
+        uint32_t row;
+    };
+
+    static bool ranksBefore(const RankKey &a, const RankKey &b)
+    {
+        if (a.percentage != b.percentage)
+            return a.percentage > b.percentage;
+        if (a.total != b.total)
+            return a.total > b.total;
+        if (a.classOrdinal != b.classOrdinal)
+            return a.classOrdinal < b.classOrdinal;
+        if (a.roll != b.roll)
+            return a.roll < b.roll;
+        return a.row < b.row;
+    }
+
+    // Sort chunks on separate threads, then merge neighbouring runs pairwise until one is left.
+    static void parallelSort(vector<RankKey> &keys, unsigned threads)
+    {
+        size_t workers = min<size_t>(threads, keys.size() / kMinRowsPerSortWorker);
+        if (workers <= 1)
+        {
+            sort(keys.begin(), keys.end(), ranksBefore);
+            return;
+        }
+
+        vector<size_t> bounds(workers + 1);
+        for (size_t i = 0; i <= workers; ++i)
+            bounds[i] = keys.size() * i / workers;
+        auto run = [&](size_t tasks, auto &&task)
+        {
+            vector<thread> pool;
+            for (size_t i = 1; i < tasks; ++i)
+                pool.emplace_back(task, i);
+            task(0); // the calling thread takes the first task
+            for (auto &t : pool)
+                t.join();
+        };
+
+        run(workers, [&](size_t i)
+            { sort(keys.begin() + bounds[i], keys.begin() + bounds[i + 1], ranksBefore); });
+        while (bounds.size() > 2)
+        {
+            size_t runs = bounds.size() - 1;
+            run(runs / 2, [&](size_t i)
+                {
+                auto first = keys.begin() + bounds[2 * i];
+                inplace_merge(first, keys.begin() + bounds[2 * i + 1], keys.begin() + bounds[2 * i + 2],
+                              ranksBefore); });
+            vector<size_t> merged;
+            for (size_t i = 0; i < bounds.size(); i += 2)
+                merged.push_back(bounds[i]);
+            if (runs % 2 != 0)
+                merged.push_back(bounds.back()); // odd run carried into the next round
+            bounds.swap(merged);
+        }
+    }
+
+    RankingResult rankRows(const StudentTable &table, unsigned threads)
+    {
+        const auto &percentages = table.percentages();
+        const auto &totals = table.totals();
+        const auto &classIds = table.classIds();
+        const auto &rolls = table.rolls();
+        size_t rows = percentages.size();
+
+        // interned ids follow first use; the tie-break wants class names in sorted order
+        vector<uint32_t> ids(classIds.empty() ? 0 : *max_element(classIds.begin(), classIds.end()) + 1);
+        for (uint32_t i = 0; i < ids.size(); ++i)
+            ids[i] = i;
+        sort(ids.begin(), ids.end(), [](uint32_t a, uint32_t b)
+             { return ClassNames::byId(a).text < ClassNames::byId(b).text; });
+        vector<uint32_t> ordinal(ids.size());
+        for (uint32_t i = 0; i < ids.size(); ++i)
+            ordinal[ids[i]] = i;
+
+        vector<RankKey> keys(rows);
+        for (size_t r = 0; r < rows; ++r)
+            keys[r] = RankKey{percentages[r], totals[r], ordinal[classIds[r]], rolls[r], static_cast<uint32_t>(r)};
+        parallelSort(keys, threads ? threads : max(1u, thread::hardware_concurrency()));
+
+        RankingResult result;
+        result.order.resize(rows);
+        result.competitionRank.resize(rows);
+        result.denseRank.resize(rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            result.order[i] = keys[i].row;
+            bool tied = i > 0 && keys[i].percentage == keys[i - 1].percentage;
+            result.competitionRank[i] = tied ? result.competitionRank[i - 1] : static_cast<uint32_t>(i + 1);
+            result.denseRank[i] = tied ? result.denseRank[i - 1] : (i == 0 ? 1 : result.denseRank[i - 1] + 1);
+        }
+        return result;
+    }
+
+} // namespace ReportCard
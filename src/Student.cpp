@@ -1,33 +1,46 @@
 #include "Student.h"
-#include <sstream>
-#include <iomanip>
+#include "BinaryIO.h"
 #include <algorithm>
+#include <charconv>
 
 using namespace std;
 
 namespace ReportCard
 {
 
+    // Shared entry for the empty class name, interned once rather than per default Student.
+    static const ClassName *emptyClass()
+    {
+        static const ClassName *entry = &ClassNames::intern("");
+        return entry;
+    }
+
     Student::Student()
-        : name_(""), className_(""), roll_(0), marks_(), total_(0), percentage_(0.0), grade_("F"), pass_(false),teacherComment_("") {}
+        : name_(""), class_(emptyClass()), roll_(0), marks_(), total_(0), percentage_(0.0), grade_(Grade::F), pass_(false),teacherComment_("") {}
+
+    Student::Student(pmr::memory_resource *resource)
+        : name_(resource), class_(emptyClass()), roll_(0), marks_(resource), total_(0), percentage_(0.0),
+          grade_(Grade::F), pass_(false), teacherComment_(resource) {}
 
     Student::Student(const string &name, const string &className, int roll, const vector<int> &marks)
-        : name_(name), className_(className), roll_(roll), marks_(marks),
+        : name_(name), class_(&ClassNames::intern(className)), roll_(roll), marks_(marks.begin(), marks.end()),
           teacherComment_("")
     {
         recalculate();
     }
 
-    const string &Student::getName() const { return name_; }
-    const string &Student::getClassName() const { return className_; }
+    string_view Student::getName() const { return name_; }
+    const string &Student::getClassName() const { return class_->text; }
+    uint32_t Student::getClassId() const { return class_->id; }
     int Student::getRoll() const { return roll_; }
-    const vector<int> &Student::getMarks() const { return marks_; }
+    MarkSpan Student::getMarks() const { return MarkSpan(marks_.data(), marks_.size()); }
     int Student::getTotal() const { return total_; }
     double Student::getPercentage() const { return percentage_; }
-    string Student::getGrade() const { return grade_; }
+    string_view Student::getGrade() const { return gradeName(grade_); }
+    Grade Student::getGradeCode() const { return grade_; }
     bool Student::isPass() const { return pass_; }
     // 🌟 NEW ACCESSOR DEFINITION (Missing linker target 1)
-    const std::string &Student::getTeacherComment() const { return teacherComment_; }
+    std::string_view Student::getTeacherComment() const { return teacherComment_; }
 
     // 🌟 NEW MUTATOR DEFINITION (Missing linker target 2)
     void Student::setTeacherComment(const std::string &comment) { teacherComment_ = comment; }
@@ -36,6 +49,27 @@ namespace ReportCard
         total_ = 0;
         for (int m : marks_)
             total_ += m;
+        refreshFromTotal();
+    }
+
+    void Student::setMarks(const vector<int> &marks)
+    {
+        marks_.assign(marks.begin(), marks.end());
+        recalculate();
+    }
+
+    bool Student::setMark(size_t subject, int mark)
+    {
+        if (subject >= marks_.size())
+            return false;
+        total_ += mark - marks_[subject];
+        marks_[subject] = mark;
+        refreshFromTotal();
+        return true;
+    }
+
+    void Student::refreshFromTotal()
+    {
         int maxTotal = static_cast<int>(marks_.size()) * 100;
         if (maxTotal > 0)
         {
@@ -46,74 +80,133 @@ namespace ReportCard
             percentage_ = 0.0;
         }
 
+        grade_ = gradeForPercentage(percentage_);
+
+        pass_ = (percentage_ >= 35.0); // pass threshold 35%
+    }
+
+    void Student::applyGradeResult(int total, double percentage, Grade grade, bool pass)
+    {
+        total_ = total;
+        percentage_ = percentage;
+        grade_ = grade;
+        pass_ = pass;
+    }
+
+    Grade gradeForPercentage(double percentage)
+    {
         // Determine grade (simple convention)
-        if (percentage_ >= 90)
-            grade_ = "A+";
-        else if (percentage_ >= 80)
-            grade_ = "A";
-        else if (percentage_ >= 70)
-            grade_ = "B+";
-        else if (percentage_ >= 60)
-            grade_ = "B";
-        else if (percentage_ >= 50)
-            grade_ = "C";
+        if (percentage >= 90)
+            return Grade::APlus;
+        else if (percentage >= 80)
+            return Grade::A;
+        else if (percentage >= 70)
+            return Grade::BPlus;
+        else if (percentage >= 60)
+            return Grade::B;
+        else if (percentage >= 50)
+            return Grade::C;
         else
-            grade_ = "F";
+            return Grade::F;
+    }
 
-        pass_ = (percentage_ >= 35.0); // pass threshold 35%
+    string_view gradeName(Grade grade)
+    {
+        static const string_view names[kGradeCount] = {"A+", "A", "B+", "B", "C", "F"};
+        return names[static_cast<int>(grade)];
     }
 
-    static string escapeCSVField(const string &s)
+    bool parseGrade(string_view text, Grade &outGrade)
     {
-        if (s.find(',') != string::npos || s.find('"') != string::npos)
+        for (int g = 0; g < kGradeCount; ++g)
         {
-            string out = "\"";
-            for (char c : s)
+            if (gradeName(static_cast<Grade>(g)) == text)
             {
-                if (c == '"')
-                    out += "\"\"";
-                else
-                    out += c;
+                outGrade = static_cast<Grade>(g);
+                return true;
             }
-            out += "\"";
-            return out;
         }
-        return s;
+        return false;
+    }
+
+    // Append a field, quoting it (and doubling inner quotes) if it contains ',' or '"'.
+    static void appendEscaped(string &out, string_view s)
+    {
+        if (s.find_first_of(",\"") == string_view::npos)
+        {
+            out.append(s);
+            return;
+        }
+        out.push_back('"');
+        for (char c : s)
+        {
+            if (c == '"')
+                out.append("\"\"");
+            else
+                out.push_back(c);
+        }
+        out.push_back('"');
+    }
+
+    // Append an int in decimal (same digits as ostream << int).
+    static void appendInt(string &out, int v)
+    {
+        char buf[16];
+        auto res = to_chars(buf, buf + sizeof buf, v);
+        out.append(buf, res.ptr);
+    }
+
+    // Append a double with exactly two decimals (same digits as fixed << setprecision(2)).
+    static void appendFixed2(string &out, double v)
+    {
+        char buf[64];
+        auto res = to_chars(buf, buf + sizeof buf, v, chars_format::fixed, 2);
+        out.append(buf, res.ptr);
     }
 
     string Student::toCSV() const
     {
-        // fields: name,class,roll,marks-semi-colon-separated,total,percentage,grade,pass
-        ostringstream oss;
-        oss << escapeCSVField(name_) << "," << escapeCSVField(className_) << "," << roll_ << ",\"";
+        string out;
+        appendCSV(out);
+        return out;
+    }
+
+    void Student::appendCSV(string &out) const
+    {
+        // fields: name,class,roll,marks-semi-colon-separated,total,percentage,grade,pass,comment
+        appendEscaped(out, name_);
+        out.push_back(',');
+        appendEscaped(out, class_->text);
+        out.push_back(',');
+        appendInt(out, roll_);
+        out.append(",\"");
         for (size_t i = 0; i < marks_.size(); ++i)
         {
             if (i)
-                oss << ";";
-            oss << marks_[i];
+                out.push_back(';');
+            appendInt(out, marks_[i]);
         }
-        oss << "\"," << total_ << "," << fixed << setprecision(2) << percentage_ << "," << grade_ << "," << (pass_ ? "1" : "0");
+        out.append("\",");
+        appendInt(out, total_);
+        out.push_back(',');
+        appendFixed2(out, percentage_);
+        out.push_back(',');
+        out.append(gradeName(grade_));
+        out.append(pass_ ? ",1," : ",0,");
 
         // 🌟 NEW FIELD 9: Teacher Comment (must be escaped)
-    oss << "," << escapeCSVField(teacherComment_); 
-
-    // Assuming history implementation is next (field 10). If you skipped history, this part is removed.
-    // 🌟 If history is implemented, the existing history serialization logic goes here, prefixed by a comma.
-    /*
-    oss << ",\"";
-    // ... history serialization logic ...
-    oss << "\""; 
-    */
-
-        return oss.str();
+        appendEscaped(out, teacherComment_);
     }
 
-    static string unescapeField(const string &s)
+    // Append the unescaped contents of a CSV field to out (strips surrounding quotes, "" -> ").
+    template <typename String> // std::string or std::pmr::string
+    static void unescapeInto(string_view field, String &out)
     {
-        if (s.size() >= 2 && s.front() == '"' && s.back() == '"')
+        out.clear();
+        if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
         {
-            string inner = s.substr(1, s.size() - 2);
-            string out;
+            string_view inner = field.substr(1, field.size() - 2);
+            out.reserve(inner.size());
             for (size_t i = 0; i < inner.size(); ++i)
             {
                 if (inner[i] == '"' && i + 1 < inner.size() && inner[i + 1] == '"')
@@ -126,110 +219,202 @@ namespace ReportCard
                     out.push_back(inner[i]);
                 }
             }
-            return out;
+            return;
         }
-        return s;
+        out.assign(field.data(), field.size());
+    }
+
+    // Parse a leading integer the way std::stoi does (leading blanks and '+' allowed,
+    // trailing characters ignored) but without allocating or throwing.
+    static bool parseInt(string_view text, int &out)
+    {
+        size_t i = 0;
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t'))
+            ++i;
+        if (i < text.size() && text[i] == '+')
+            ++i;
+        const char *first = text.data() + i;
+        const char *last = text.data() + text.size();
+        auto res = from_chars(first, last, out);
+        return res.ec == errc() && res.ptr != first;
     }
 
-    bool Student::fromCSV(const string &line, Student &outStudent)
+    bool Student::fromCSV(string_view line, Student &outStudent)
     {
-        // naive CSV split that handles quoted field for marks.
-        vector<string> fields;
-        string cur;
+        // fields: name,class,roll,"marks",total,percentage,grade,pass,teacherComment[,...]
+        // Commas inside quotes do not split; quotes are kept in the field views.
+        const size_t kFields = 9;
+        string_view fields[kFields];
+        size_t count = 0;
+        size_t start = 0;
         bool inQuotes = false;
-        for (size_t i = 0; i < line.size(); ++i)
+        for (size_t i = 0; i < line.size() && count < kFields; ++i)
         {
             char c = line[i];
             if (c == '"')
             {
                 inQuotes = !inQuotes;
-                cur.push_back(c);
             }
             else if (c == ',' && !inQuotes)
             {
-                fields.push_back(cur);
-                cur.clear();
-            }
-            else
-            {
-                cur.push_back(c);
+                fields[count++] = line.substr(start, i - start);
+                start = i + 1;
             }
         }
-        fields.push_back(cur);
+        if (count < kFields)
+            fields[count++] = line.substr(start);
+
+        if (count < kFields)
+            return false; // we expect at least 9 fields
 
-        // 🌟 CHECK FIELD COUNT: 
-    // 9 fields if history is NOT implemented (8 existing + 1 comment)
-    // 10 fields if history IS implemented (8 existing + 1 comment + 1 history)
-        if (fields.size() < 9)
-            return false; // we expect at least 8 fields
+        int roll;
+        if (!parseInt(fields[2], roll))
+            return false;
 
-        string name = unescapeField(fields[0]);
-        string className = unescapeField(fields[1]);
-        int roll = stoi(fields[2]);
+        unescapeInto(fields[0], outStudent.name_);
+        string_view classField = fields[1];
+        if (classField.size() >= 2 && classField.front() == '"' && classField.back() == '"')
+        {
+            thread_local string unescaped;
+            unescapeInto(classField, unescaped);
+            classField = unescaped;
+        }
+        outStudent.class_ = &ClassNames::intern(classField);
+        outStudent.roll_ = roll;
 
-        string marksField = unescapeField(fields[3]);
-        vector<int> marks;
+        // marks are stored quoted and ';'-separated; tokens that are not numbers read as 0
+        string_view marksField = fields[3];
+        string unquoted;
+        if (marksField.size() >= 2 && marksField.front() == '"' && marksField.back() == '"')
+        {
+            marksField = marksField.substr(1, marksField.size() - 2);
+            if (marksField.find('"') != string_view::npos)
+            {
+                unescapeInto(fields[3], unquoted);
+                marksField = unquoted;
+            }
+        }
+        outStudent.marks_.clear();
         if (!marksField.empty())
         {
-            stringstream sm(marksField);
-            string token;
-            while (getline(sm, token, ';'))
+            outStudent.marks_.reserve(count_if(marksField.begin(), marksField.end(), [](char c)
+                                               { return c == ';'; }) + 1);
+            size_t pos = 0;
+            while (pos <= marksField.size())
             {
-                try
-                {
-                    marks.push_back(stoi(token));
-                }
-                catch (...)
+                size_t semi = marksField.find(';', pos);
+                if (semi == string_view::npos)
                 {
-                    marks.push_back(0);
+                    // a trailing ';' does not start another mark
+                    if (pos == marksField.size() && pos > 0)
+                        break;
+                    semi = marksField.size();
                 }
+                int mark;
+                outStudent.marks_.push_back(parseInt(marksField.substr(pos, semi - pos), mark) ? mark : 0);
+                pos = semi + 1;
             }
         }
 
-        Student s(name, className, roll, marks);
+        unescapeInto(fields[8], outStudent.teacherComment_);
+
         // recalculate ensures computed fields match
-        s.recalculate();
-  
-        // 🌟 NEW FIELD PARSING: Teacher Comment (Field 8 if 0-indexed, or index fields.size() - 2 if history is the last field)
-    // Assuming the order is: ...,pass,teacherComment,history
-    size_t commentIndex = 8; 
+        outStudent.recalculate();
+        return true;
+    }
 
-    string comment = unescapeField(fields[commentIndex]);
-    s.teacherComment_ = comment; // Set the new member
+    void Student::appendBinary(string &out) const
+    {
+        putString(out, name_);
+        putString(out, class_->text);
+        putI32(out, roll_);
+        putU32(out, static_cast<uint32_t>(marks_.size()));
+        for (int m : marks_)
+            putI32(out, m);
+        putI32(out, total_);
+        putF64(out, percentage_);
+        putU8(out, static_cast<uint8_t>(grade_));
+        putU8(out, pass_ ? 1 : 0);
+        putString(out, teacherComment_);
+    }
 
-        outStudent = s;
+    bool Student::fromBinary(BinaryReader &in, Student &outStudent)
+    {
+        int32_t roll;
+        uint32_t markCount;
+        thread_local string className;
+        if (!in.getString(outStudent.name_) || !in.getString(className) ||
+            !in.getI32(roll) || !in.getU32(markCount))
+            return false;
+        outStudent.class_ = &ClassNames::intern(className);
+        outStudent.roll_ = roll;
+
+        outStudent.marks_.clear();
+        outStudent.marks_.reserve(min<uint32_t>(markCount, 1024)); // don't trust a corrupt count
+        for (uint32_t i = 0; i < markCount; ++i)
+        {
+            int32_t m;
+            if (!in.getI32(m))
+                return false;
+            outStudent.marks_.push_back(m);
+        }
+
+        int32_t total;
+        double percentage;
+        uint8_t grade, pass;
+        if (!in.getI32(total) || !in.getF64(percentage) || !in.getU8(grade) || !in.getU8(pass) ||
+            grade >= kGradeCount || !in.getString(outStudent.teacherComment_))
+            return false;
+        outStudent.total_ = total;
+        outStudent.percentage_ = percentage;
+        outStudent.grade_ = static_cast<Grade>(grade);
+        outStudent.pass_ = pass != 0;
         return true;
     }
 
     string Student::formattedReportCard() const
     {
-        ostringstream oss;
-        oss << "------------------------------------------\n";
-        oss << "Report Card\n";
-        oss << "Name    : " << name_ << "\n";
-        oss << "Class   : " << className_ << "\n";
-        oss << "Roll No.: " << roll_ << "\n";
-        oss << "Marks   : ";
+        string out;
+        appendReportCard(out);
+        return out;
+    }
+
+    void Student::appendReportCard(string &out) const
+    {
+        static const string_view kHead = "------------------------------------------\n"
+                                         "Report Card\n"
+                                         "Name    : ";
+        static const string_view kCommentHead = "------------------------------------------\n"
+                                                "Teacher Comments:\n";
+        static const string_view kTail = "------------------------------------------\n"
+                                         "------------------------------------------\n";
+
+        out.append(kHead);
+        out.append(name_);
+        out.append("\nClass   : ");
+        out.append(class_->text);
+        out.append("\nRoll No.: ");
+        appendInt(out, roll_);
+        out.append("\nMarks   : ");
         for (size_t i = 0; i < marks_.size(); ++i)
         {
-            oss << marks_[i];
+            appendInt(out, marks_[i]);
             if (i + 1 < marks_.size())
-                oss << ", ";
+                out.append(", ");
         }
-        oss << "\n";
-        oss << "Total   : " << total_ << "\n";
-        oss << "Percent : " << fixed << setprecision(2) << percentage_ << "%\n";
-        oss << "Grade   : " << grade_ << "\n";
-        oss << "Result  : " << (pass_ ? "PASS" : "FAIL") << "\n";
+        out.append("\nTotal   : ");
+        appendInt(out, total_);
+        out.append("\nPercent : ");
+        appendFixed2(out, percentage_);
+        out.append("%\nGrade   : ");
+        out.append(gradeName(grade_));
+        out.append(pass_ ? "\nResult  : PASS\n" : "\nResult  : FAIL\n");
 
         // 🌟 NEW DISPLAY FIELD
-    oss << "------------------------------------------\n";
-    oss << "Teacher Comments:\n";
-    oss << teacherComment_ << "\n";
-    oss << "------------------------------------------\n"; 
-
-        oss << "------------------------------------------\n";
-        return oss.str();
+        out.append(kCommentHead);
+        out.append(teacherComment_);
+        out.push_back('\n');
+        out.append(kTail);
     }
 
 } // namespace ReportCard
@@ -0,0 +1,150 @@
+#include "StudentCursor.h"
+#include "ClassNames.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    bool ScanFilter::matches(const Student &s) const
+    {
+        if (!className.empty() && s.getClassName() != className)
+            return false;
+        if (result == Result::Passed && !s.isPass())
+            return false;
+        if (result == Result::Failed && s.isPass())
+            return false;
+        double p = s.getPercentage();
+        return p >= minPercentage && p <= maxPercentage;
+    }
+
+    StudentCursor::StudentCursor(const string &path, ScanFilter filter, size_t bufferBytes)
+        : in_(path, ios::binary), filter_(move(filter)), buffer_(max<size_t>(bufferBytes, 4096))
+    {
+    }
+
+    bool StudentCursor::isOpen() const
+    {
+        return in_.is_open();
+    }
+
+    bool StudentCursor::nextLine(string_view &line)
+    {
+        for (;;)
+        {
+            const char *base = buffer_.data();
+            const char *nl = static_cast<const char *>(memchr(base + begin_, '\n', end_ - begin_));
+            lineOffset_ = bufferOffset_ + begin_;
+            if (nl)
+            {
+                line = string_view(base + begin_, static_cast<size_t>(nl - (base + begin_)));
+                begin_ = static_cast<size_t>(nl - base) + 1;
+                return true;
+            }
+            if (eof_)
+            {
+                // last line without a trailing newline
+                if (begin_ == end_)
+                    return false;
+                line = string_view(base + begin_, end_ - begin_);
+                begin_ = end_;
+                return true;
+            }
+
+            // keep the partial line, then refill behind it
+            size_t pending = end_ - begin_;
+            if (pending == buffer_.size())
+                buffer_.resize(buffer_.size() * 2); // one line fills the buffer: grow for it
+            memmove(buffer_.data(), buffer_.data() + begin_, pending);
+            bufferOffset_ += begin_;
+            begin_ = 0;
+            end_ = pending;
+            in_.read(buffer_.data() + end_, static_cast<streamsize>(buffer_.size() - end_));
+            end_ += static_cast<size_t>(in_.gcount());
+            if (!in_)
+                eof_ = true;
+        }
+    }
+
+    bool StudentCursor::next()
+    {
+        if (!in_.is_open())
+            return false;
+        string_view line;
+        while (nextLine(line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                continue;
+            lineLength_ = line.size();
+            if (!Student::fromCSV(line, current_))
+            {
+                ++parseFailures_;
+                continue;
+            }
+            ++recordsRead_;
+            if (filter_.matches(current_))
+                return true;
+        }
+        return false;
+    }
+
+    const Student &StudentCursor::current() const
+    {
+        return current_;
+    }
+
+    uint64_t StudentCursor::currentOffset() const
+    {
+        return lineOffset_;
+    }
+
+    size_t StudentCursor::currentLength() const
+    {
+        return lineLength_;
+    }
+
+    size_t StudentCursor::recordsRead() const
+    {
+        return recordsRead_;
+    }
+
+    size_t StudentCursor::parseFailures() const
+    {
+        return parseFailures_;
+    }
+
+    bool scanSummaries(const string &path, const ScanFilter &filter, ScanSummary &out)
+    {
+        out = ScanSummary();
+        StudentCursor cursor(path, filter);
+        if (!cursor.isOpen())
+            return false;
+
+        vector<ClassSummary> perClass; // indexed by ClassNames id
+        while (cursor.next())
+        {
+            const Student &s = cursor.current();
+            out.all.add(s);
+            if (s.getClassId() >= perClass.size())
+                perClass.resize(s.getClassId() + 1);
+            perClass[s.getClassId()].add(s);
+        }
+
+        for (uint32_t id = 0; id < perClass.size(); ++id)
+        {
+            if (perClass[id].count > 0)
+                out.byClass.emplace_back(ClassNames::byId(id).text, move(perClass[id]));
+        }
+        sort(out.byClass.begin(), out.byClass.end(),
+             [](const auto &a, const auto &b)
+             { return a.first < b.first; });
+        out.recordsRead = cursor.recordsRead();
+        out.parseFailures = cursor.parseFailures();
+        return true;
+    }
+
+} // namespace ReportCard
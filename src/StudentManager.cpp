@@ -1,30 +1,434 @@
 #include "StudentManager.h"
+#include "MappedFile.h"
+#include "BinaryIO.h"
+#include "DiskIndex.h"
+#include "FileIO.h"
+#include "Metrics.h"
+#include "Ranking.h"
 #include <fstream>
 #include <algorithm>
-#include <cstdio> // rename
+#include <cstdio> // remove
+#include <cstring>
 #include <iostream>
+#include <filesystem>
+#include <sstream>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <cctype>
+#include <charconv>
+#include <unordered_set>
 
 using namespace std;
 
 namespace ReportCard
 {
 
-    StudentManager::StudentManager(const string &filename) : filename_(filename)
+    // Never checkpoint a journal shorter than this, even for tiny data sets.
+    static const size_t kMinCheckpointRecords = 1024;
+
+    // Rows a journaled background pass encodes per hold of the store lock, and how many times
+    // it starts over (rows added, removed or reordered meanwhile) before taking the lock for
+    // the whole encode.
+    static const size_t kEncodeSliceRows = 4096;
+    static const unsigned kMaxEncodeRestarts = 3;
+
+    // First slab of each load arena; monotonic_buffer_resource grows later slabs geometrically.
+    static const size_t kArenaSlabBytes = 1 << 20;
+
+    // Parse every non-empty '\n'-terminated line of text, skipping lines fromCSV rejects. A
+    // trailing '\r' (a CSV saved by a Windows tool) is not part of the record, as in StudentCursor.
+    // Records allocate from resource (the heap by default). Returns the number of rejected lines.
+    static size_t parseLines(string_view text, vector<Student> &out,
+                             pmr::memory_resource *resource = pmr::get_default_resource())
+    {
+        size_t failures = 0;
+        size_t pos = 0;
+        while (pos < text.size())
+        {
+            size_t nl = text.find('\n', pos);
+            if (nl == string_view::npos)
+                nl = text.size();
+            string_view line = text.substr(pos, nl - pos);
+            pos = nl + 1;
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                continue;
+            out.emplace_back(resource);
+            if (!Student::fromCSV(line, out.back()))
+            {
+                out.pop_back(); // skip bad lines but continue
+                ++failures;
+            }
+        }
+        return failures;
+    }
+
+    StudentManager::StudentManager(const string &filename, unsigned loadThreads, bool arenaStorage)
+        : filename_(filename), loadThreads_(loadThreads), arenaStorage_(arenaStorage)
     {
         loadFromFile();
     }
 
-    bool StudentManager::addStudent(const Student &s)
+    // Below this size a parallel load costs more in thread start-up than it saves.
+    static const size_t kMinParallelLoadBytes = 1 << 20;
+
+    // Parse text on up to `threads` workers. Each chunk ends just after a '\n'; every line is
+    // one record (fromCSV resets its quote state per line and toCSV never writes a newline
+    // inside a field), so chunks hold whole records and parse exactly as a serial pass would.
+    // With arenas, each chunk gets its own arena (appended to *arenas): monotonic resources
+    // are not thread-safe, and private arenas also keep workers from contending on malloc.
+    static size_t parseLinesParallel(string_view text, unsigned threads, vector<Student> &out,
+                                     vector<unique_ptr<pmr::monotonic_buffer_resource>> *arenas)
     {
-        for (const auto &st : students_)
+        vector<string_view> chunks;
+        size_t target = text.size() / threads + 1;
+        size_t pos = 0;
+        while (pos < text.size())
         {
-            if (st.getRoll() == s.getRoll() && st.getClassName() == s.getClassName())
+            size_t end = pos + target;
+            if (end >= text.size())
             {
-                return false; // duplicate roll in same class
+                end = text.size();
             }
+            else
+            {
+                size_t nl = text.find('\n', end);
+                end = nl == string_view::npos ? text.size() : nl + 1;
+            }
+            chunks.push_back(text.substr(pos, end - pos));
+            pos = end;
+        }
+
+        vector<pmr::memory_resource *> resources(chunks.size(), pmr::get_default_resource());
+        if (arenas)
+        {
+            for (auto &r : resources)
+            {
+                arenas->push_back(make_unique<pmr::monotonic_buffer_resource>(kArenaSlabBytes));
+                r = arenas->back().get();
+            }
+        }
+
+        vector<vector<Student>> parts(chunks.size());
+        vector<size_t> failures(chunks.size());
+        vector<thread> workers;
+        for (size_t i = 1; i < chunks.size(); ++i)
+            workers.emplace_back([&, i]
+                                 { failures[i] = parseLines(chunks[i], parts[i], resources[i]); });
+        // the calling thread takes the first chunk
+        failures[0] = parseLines(chunks[0], parts[0], resources[0]);
+        for (auto &w : workers)
+            w.join();
+
+        size_t total = out.size();
+        for (const auto &p : parts)
+            total += p.size();
+        out.reserve(total);
+        for (auto &p : parts)
+            move(p.begin(), p.end(), back_inserter(out));
+        return accumulate(failures.begin(), failures.end(), size_t(0));
+    }
+
+    // Binary snapshot layout (little-endian):
+    //   magic[8] "RCSNAP\0\1", u32 version, u32 flags, u64 csvSize, u64 csvMtime, u64 count,
+    //   count x Student record, u64 checksum of every preceding byte.
+    static const char kSnapshotMagic[8] = {'R', 'C', 'S', 'N', 'A', 'P', '\0', '\1'};
+    static const uint32_t kSnapshotVersion = 1;
+
+    static bool writeFile(const string &path, const string &bytes, ios::openmode mode)
+    {
+        ofstream ofs(path, mode | ios::trunc);
+        if (!ofs.is_open())
+            return false;
+        ofs.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+        ofs.close();
+        if (!ofs)
+            return false;
+        Metrics::add(MetricCounter::BytesWritten, bytes.size());
+        return true;
+    }
+
+    // Write bytes to path through a temporary file, so path never holds a partial write.
+    static bool writeFileReplacing(const string &path, const string &bytes, ios::openmode mode)
+    {
+        string tmp = path + ".tmp";
+        return writeFile(tmp, bytes, mode) && replaceWithTemp(tmp, path);
+    }
+
+    // Offset of the csvSize field in the snapshot header (after magic, version and flags).
+    static const size_t kSnapshotIdentityOffset = sizeof kSnapshotMagic + 4 + 4;
+
+    // Snapshot header for count records; the records and checksum follow.
+    static void beginSnapshot(uint64_t count, uint64_t csvSize, uint64_t csvMtime, string &buf)
+    {
+        buf.append(kSnapshotMagic, sizeof kSnapshotMagic);
+        putU32(buf, kSnapshotVersion);
+        putU32(buf, 0);
+        putU64(buf, csvSize);
+        putU64(buf, csvMtime);
+        putU64(buf, count);
+    }
+
+    // Encode a snapshot; the CSV identity can be filled in later with stampSnapshot().
+    static void encodeSnapshot(const vector<Student> &students, uint64_t csvSize, uint64_t csvMtime,
+                               string &buf)
+    {
+        beginSnapshot(students.size(), csvSize, csvMtime, buf);
+        for (const auto &s : students)
+            s.appendBinary(buf);
+        putU64(buf, checksum64(buf.data(), buf.size()));
+    }
+
+    // Rewrite the CSV identity of an encoded snapshot and its trailing checksum.
+    static void stampSnapshot(string &buf, uint64_t csvSize, uint64_t csvMtime)
+    {
+        string identity;
+        putU64(identity, csvSize);
+        putU64(identity, csvMtime);
+        buf.replace(kSnapshotIdentityOffset, identity.size(), identity);
+        buf.resize(buf.size() - 8);
+        putU64(buf, checksum64(buf.data(), buf.size()));
+    }
+
+    static bool writeSnapshotFile(const string &path, const vector<Student> &students,
+                                  uint64_t csvSize, uint64_t csvMtime)
+    {
+        string buf;
+        encodeSnapshot(students, csvSize, csvMtime, buf);
+        return writeFileReplacing(path, buf, ios::binary);
+    }
+
+    // Validate and decode a snapshot. out is only filled if the whole file is valid.
+    static bool readSnapshotFile(const string &path, uint64_t &csvSize, uint64_t &csvMtime,
+                                 vector<Student> &out,
+                                 pmr::memory_resource *resource = pmr::get_default_resource())
+    {
+        MappedFile file(path);
+        const size_t headerSize = sizeof kSnapshotMagic + 4 + 4 + 8 + 8 + 8;
+        if (!file.isOpen() || file.size() < headerSize + 8 ||
+            memcmp(file.data(), kSnapshotMagic, sizeof kSnapshotMagic) != 0)
+            return false;
+        Metrics::add(MetricCounter::BytesRead, file.size()); // the checksum reads all of it
+
+        const char *end = file.data() + file.size() - 8;
+        uint64_t stored;
+        BinaryReader tail(end, end + 8);
+        tail.getU64(stored);
+        if (stored != checksum64(file.data(), file.size() - 8))
+            return false;
+
+        BinaryReader in(file.data() + sizeof kSnapshotMagic, end);
+        uint32_t version, flags;
+        uint64_t count;
+        if (!in.getU32(version) || !in.getU32(flags) || !in.getU64(csvSize) ||
+            !in.getU64(csvMtime) || !in.getU64(count) || version != kSnapshotVersion)
+            return false;
+
+        vector<Student> students;
+        students.reserve(static_cast<size_t>(min<uint64_t>(count, file.size() / 16)));
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            students.emplace_back(resource);
+            if (!Student::fromBinary(in, students.back()))
+                return false;
         }
+        if (!in.atEnd())
+            return false;
+        out.swap(students);
+        return true;
+    }
+
+    // First line of a journal: the identity (size, mtime) of the CSV its records apply on top of.
+    static string journalHeader(uint64_t csvSize, uint64_t csvMtime)
+    {
+        return "#base," + to_string(csvSize) + "," + to_string(csvMtime);
+    }
+
+    // The journal from byte offset `from` on; from 0, everything after the header line.
+    static bool journalTail(const string &path, uint64_t from, string &tail)
+    {
+        ifstream ifs(path, ios::binary);
+        string header;
+        if (!ifs.is_open() || (from == 0 ? !getline(ifs, header) : !ifs.seekg(static_cast<streamoff>(from))))
+            return false;
+        tail.assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+        return true;
+    }
+
+    // --- Journal record builders (one line each; see applyJournalRecord) ---
+    static string addRecord(const Student &s)
+    {
+        return "A," + s.toCSV();
+    }
+
+    static string removeRecord(int roll)
+    {
+        return "D," + to_string(roll);
+    }
+
+    template <typename Marks> // std::vector<int> or a student's MarkSpan
+    static string marksRecord(int roll, const Marks &marks)
+    {
+        string record = "M," + to_string(roll) + ",";
+        for (size_t i = 0; i < marks.size(); ++i)
+        {
+            if (i)
+                record += ";";
+            record += to_string(marks[i]);
+        }
+        return record;
+    }
+
+    static string commentRecord(int roll, const string &comment)
+    {
+        return "C," + to_string(roll) + "," + comment;
+    }
+
+    bool StudentManager::addStudent(const Student &s)
+    {
+        auto store = lockStore();
+        if (!insertStudent(s))
+            return false; // duplicate roll in same class
+        return persist(addRecord(s));
+    }
+
+    bool StudentManager::insertStudent(const Student &s)
+    {
+        size_t pos = students_.size();
+        if (!keyIndex_.emplace(ClassRollKey{s.getClassId(), s.getRoll()}, pos).second)
+            return false; // duplicate roll in same class
         students_.push_back(s);
-        return saveToFile();
+        rollIndex_[s.getRoll()].push_back(pos);
+        table_.append(s);
+        ++rowsVersion_;
+        return true;
+    }
+
+    void StudentBatch::addStudent(const Student &s)
+    {
+        Operation op{Operation::Kind::Add, s.getRoll(), s, {}, {}};
+        ops_.push_back(std::move(op));
+    }
+
+    void StudentBatch::editMarks(int roll, const vector<int> &newMarks)
+    {
+        ops_.push_back(Operation{Operation::Kind::EditMarks, roll, Student(), newMarks, {}});
+    }
+
+    void StudentBatch::editTeacherComment(int roll, const string &comment)
+    {
+        ops_.push_back(Operation{Operation::Kind::EditComment, roll, Student(), {}, comment});
+    }
+
+    void StudentBatch::removeByRoll(int roll)
+    {
+        ops_.push_back(Operation{Operation::Kind::Remove, roll, Student(), {}, {}});
+    }
+
+    size_t StudentBatch::size() const { return ops_.size(); }
+    bool StudentBatch::empty() const { return ops_.empty(); }
+    void StudentBatch::clear() { ops_.clear(); }
+
+    StudentBatch StudentManager::beginBatch() const
+    {
+        return StudentBatch();
+    }
+
+    BatchResult StudentManager::commitBatch(const StudentBatch &batch)
+    {
+        using Kind = StudentBatch::Operation::Kind;
+        BatchResult result;
+
+        // 1. validate: track the classes holding each touched roll as the batch would leave them
+        unordered_map<int, vector<uint32_t>> shadow;
+        auto classesOf = [&](int roll) -> vector<uint32_t> &
+        {
+            auto it = shadow.find(roll);
+            if (it != shadow.end())
+                return it->second;
+            vector<uint32_t> &classes = shadow[roll];
+            auto pos = rollIndex_.find(roll);
+            if (pos != rollIndex_.end())
+                for (size_t p : pos->second)
+                    classes.push_back(students_[p].getClassId());
+            return classes;
+        };
+        for (size_t i = 0; i < batch.ops_.size(); ++i)
+        {
+            const auto &op = batch.ops_[i];
+            vector<uint32_t> &classes = classesOf(op.roll);
+            bool ok = true;
+            switch (op.kind)
+            {
+            case Kind::Add:
+                ok = find(classes.begin(), classes.end(), op.student.getClassId()) == classes.end();
+                if (ok)
+                    classes.push_back(op.student.getClassId());
+                break;
+            case Kind::Remove:
+                ok = !classes.empty();
+                classes.clear();
+                break;
+            case Kind::EditMarks:
+            case Kind::EditComment:
+                ok = !classes.empty();
+                break;
+            }
+            if (!ok)
+                result.rejectedIndexes.push_back(i);
+        }
+        result.rejected = result.rejectedIndexes.size();
+        if (result.rejected > 0 || batch.empty())
+        {
+            result.committed = batch.empty();
+            return result;
+        }
+
+        // 2. apply in memory (cannot fail after validation) and collect journal records;
+        //    a write-behind pass sees the batch entirely or replays it from the journal
+        vector<string> records;
+        records.reserve(batch.ops_.size());
+        auto store = lockStore();
+        for (const auto &op : batch.ops_)
+        {
+            switch (op.kind)
+            {
+            case Kind::Add:
+                insertStudent(op.student);
+                records.push_back(addRecord(op.student));
+                break;
+            case Kind::Remove:
+                eraseRoll(op.roll);
+                records.push_back(removeRecord(op.roll));
+                break;
+            case Kind::EditMarks:
+                replaceMarks(op.roll, op.marks);
+                records.push_back(marksRecord(op.roll, op.marks));
+                break;
+            case Kind::EditComment:
+                replaceComment(op.roll, op.comment);
+                records.push_back(commentRecord(op.roll, op.comment));
+                break;
+            }
+        }
+
+        // 3. one durable write; on failure fall back to what is on disk
+        bool persisted = persistRecords(records);
+        store = unique_lock<mutex>();
+        if (!persisted)
+        {
+            loadFromFile();
+            return result;
+        }
+        result.committed = true;
+        result.applied = batch.ops_.size();
+        return result;
     }
 
     const vector<Student> &StudentManager::getAll() const
@@ -32,36 +436,80 @@ namespace ReportCard
         return students_;
     }
 
+    ptrdiff_t StudentManager::rowOfRoll(int roll) const
+    {
+        auto it = rollIndex_.find(roll);
+        if (it == rollIndex_.end())
+            return -1;
+        return static_cast<ptrdiff_t>(it->second.front());
+    }
+
+    // Only the public lookups are timed; edits go through rowOfRoll() directly.
     Student *StudentManager::findByRoll(int roll)
     {
-        for (auto &st : students_)
-        {
-            if (st.getRoll() == roll)
-                return &st;
-        }
-        return nullptr;
+        Metrics::Timer timer(MetricOp::Lookup);
+        ptrdiff_t row = rowOfRoll(roll);
+        return row < 0 ? nullptr : &students_[row];
+    }
+
+    const Student *StudentManager::findByRoll(int roll) const
+    {
+        Metrics::Timer timer(MetricOp::Lookup);
+        ptrdiff_t row = rowOfRoll(roll);
+        return row < 0 ? nullptr : &students_[row];
     }
 
     bool StudentManager::removeByRoll(int roll)
     {
+        auto store = lockStore();
+        if (!eraseRoll(roll))
+            return false;
+        return persist(removeRecord(roll));
+    }
+
+    bool StudentManager::eraseRoll(int roll)
+    {
+        if (rollIndex_.find(roll) == rollIndex_.end())
+            return false;
         auto it = remove_if(students_.begin(), students_.end(), [roll](const Student &s)
                             { return s.getRoll() == roll; });
         if (it == students_.end())
             return false;
         students_.erase(it, students_.end());
-        return saveToFile();
+        // positions after the first removed student shifted
+        rebuildIndex();
+        return true;
     }
 
     bool StudentManager::editMarks(int roll, const vector<int> &newMarks)
     {
-        Student *s = findByRoll(roll);
-        if (!s)
+        auto store = lockStore();
+        if (!replaceMarks(roll, newMarks))
             return false;
-        // create a new student with same metadata but new marks
-        Student updated(s->getName(), s->getClassName(), s->getRoll(), newMarks);
-        *s = updated;
-        s->recalculate();
-        return saveToFile();
+        return persist(marksRecord(roll, newMarks));
+    }
+
+    bool StudentManager::replaceMarks(int roll, const vector<int> &newMarks)
+    {
+        ptrdiff_t row = rowOfRoll(roll);
+        if (row < 0)
+            return false;
+        Student &s = students_[row];
+        s.setMarks(newMarks); // in place: name, class and teacher comment are kept
+        table_.update(static_cast<size_t>(row), s);
+        return true;
+    }
+
+    bool StudentManager::editMark(int roll, size_t subject, int mark)
+    {
+        auto store = lockStore();
+        ptrdiff_t row = rowOfRoll(roll);
+        if (row < 0 || !students_[row].setMark(subject, mark))
+            return false;
+        const Student &s = students_[row];
+        table_.updateMark(static_cast<size_t>(row), subject, s);
+        // journal the resulting marks so replay reuses the ordinary marks record
+        return persist(marksRecord(roll, s.getMarks()));
     }
 // 🌟 NEW FUNCTION: Edit Teacher Comment
     /**
@@ -72,112 +520,1053 @@ namespace ReportCard
      */
     bool StudentManager::editTeacherComment(int roll, const std::string& comment)
     {
-        // 1. Find the student by roll number (mutable reference needed)
-        Student* s = findByRoll(roll);
-        
-        if (!s) {
+        // 1. Find the student and update the teacherComment_ field in memory
+        auto store = lockStore();
+        if (!replaceComment(roll, comment)) {
             return false; // Student not found
         }
-        
-        // 2. Update the teacherComment_ field using the Student's setter
-        // Note: The Student class must have a setTeacherComment(string) method for this to compile.
-        s->setTeacherComment(comment);
-        
-        // 3. Save all students back to the CSV file to persist the change
-        return saveToFile();
+
+        // 2. Persist the change (journal record or full CSV rewrite)
+        return persist(commentRecord(roll, comment));
+    }
+
+    bool StudentManager::replaceComment(int roll, const string &comment)
+    {
+        ptrdiff_t row = rowOfRoll(roll);
+        if (row < 0)
+            return false;
+        students_[row].setTeacherComment(comment);
+        return true;
     }
     const Student *StudentManager::getTopper() const
     {
-        if (students_.empty())
-            return nullptr;
-        const Student *topper = &students_[0];
+        ptrdiff_t row = table_.topperRow();
+        return row < 0 ? nullptr : &students_[row];
+    }
+
+    vector<const Student *> StudentManager::topK(size_t k) const
+    {
+        vector<const Student *> result;
+        for (size_t row : table_.topRows(k))
+            result.push_back(&students_[row]);
+        return result;
+    }
+
+    vector<const Student *> StudentManager::topKByClass(const string &className, size_t k) const
+    {
+        vector<const Student *> result;
+        uint32_t classId;
+        if (!table_.findClass(className, classId))
+            return result;
+        for (size_t row : table_.topRows(k, classId))
+            result.push_back(&students_[row]);
+        return result;
+    }
+
+    size_t StudentManager::rankOf(int roll) const
+    {
+        auto it = rollIndex_.find(roll);
+        if (it == rollIndex_.end())
+            return 0;
+        return 1 + table_.countAbove(table_.percentages()[it->second.front()]);
+    }
+
+    vector<RankedStudent> StudentManager::ranking(unsigned threads) const
+    {
+        RankingResult ranked = rankRows(table_, threads);
+        vector<RankedStudent> result;
+        result.reserve(ranked.order.size());
+        for (size_t i = 0; i < ranked.order.size(); ++i)
+            result.push_back(RankedStudent{&students_[ranked.order[i]], ranked.competitionRank[i], ranked.denseRank[i]});
+        return result;
+    }
+
+    size_t StudentManager::regradeAll()
+    {
+        auto store = lockStore();
+        ++rowsVersion_; // not journaled: a sliced background encode must not mix old and new grades
+        table_.regrade();
+        size_t changed = 0;
+        for (size_t i = 0; i < students_.size(); ++i)
+        {
+            Student &s = students_[i];
+            Grade grade = table_.grades()[i];
+            bool pass = table_.passFlags()[i] != 0;
+            if (s.getTotal() == table_.totals()[i] && s.getPercentage() == table_.percentages()[i] &&
+                s.getGradeCode() == grade && s.isPass() == pass)
+                continue;
+            s.applyGradeResult(table_.totals()[i], table_.percentages()[i], grade, pass);
+            ++changed;
+        }
+        return changed;
+    }
+
+    // saveToFile() writes its buffer out whenever it grows past this size.
+    static const size_t kSaveFlushBytes = 1 << 20;
+
+    // Buffered output is handed to the sink once it grows past this size.
+    static const size_t kRenderFlushBytes = 1 << 16;
+
+    bool StudentManager::renderAll(ostream &sink, string_view separator) const
+    {
+        string buf;
+        buf.reserve(kRenderFlushBytes + 1024);
         for (const auto &s : students_)
         {
-            if (s.getPercentage() > topper->getPercentage())
-                topper = &s;
+            s.appendReportCard(buf);
+            buf.append(separator);
+            if (buf.size() >= kRenderFlushBytes)
+            {
+                sink.write(buf.data(), static_cast<streamsize>(buf.size()));
+                buf.clear();
+            }
         }
-        return topper;
+        sink.write(buf.data(), static_cast<streamsize>(buf.size()));
+        return static_cast<bool>(sink);
+    }
+
+    // Students a worker claims at once during exportReportCards().
+    static const size_t kExportBlock = 64;
+
+    // Counting semaphore bounding how many export files are open at once.
+    class FileSlots
+    {
+    public:
+        explicit FileSlots(unsigned slots) : free_(slots ? slots : 1) {}
+        void acquire()
+        {
+            unique_lock<mutex> lock(mutex_);
+            cv_.wait(lock, [this]
+                     { return free_ > 0; });
+            --free_;
+        }
+        void release()
+        {
+            {
+                lock_guard<mutex> lock(mutex_);
+                ++free_;
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        mutex mutex_;
+        condition_variable cv_;
+        unsigned free_;
+    };
+
+    // Class name as a single safe path component.
+    static string safePathComponent(const string &name)
+    {
+        string out = name;
+        for (char &c : out)
+        {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '.')
+                c = '_';
+        }
+        if (out.empty())
+            out = "_";
+        if (out[0] == '.')
+            out[0] = '_'; // no hidden directories, no "." or ".."
+        return out;
+    }
+
+    ExportResult StudentManager::exportReportCards(const string &directory, unsigned threads,
+                                                   unsigned maxOpenFiles) const
+    {
+        ExportResult result;
+        auto t0 = chrono::steady_clock::now();
+
+        // one directory per class, created before the workers start. Different names can map to
+        // the same directory ("10/A" and "10_A", or "10A" and "10a" on a case-insensitive
+        // filesystem); in name order, the first keeps it and the others get "~2", "~3", ...
+        // ('~' never survives safePathComponent, so a suffixed name cannot clash with a plain one)
+        vector<string> classDirs(table_.classCount());
+        vector<uint32_t> ids;
+        for (uint32_t id = 0; id < classDirs.size(); ++id)
+        {
+            if (!table_.rowsOfClass(id).empty())
+                ids.push_back(id);
+        }
+        sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b)
+             { return table_.className(a) < table_.className(b); });
+        unordered_set<string> taken; // lower-cased directory names
+        for (uint32_t id : ids)
+        {
+            string base = safePathComponent(table_.className(id)), dir = base;
+            for (unsigned n = 2;; ++n)
+            {
+                string key = dir;
+                for (char &c : key)
+                    c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+                if (taken.insert(key).second)
+                    break;
+                dir = base + "~" + to_string(n);
+            }
+            classDirs[id] = (filesystem::path(directory) / dir).string();
+            error_code ec;
+            filesystem::create_directories(classDirs[id], ec);
+            if (ec)
+                result.failures.emplace_back(classDirs[id], ec.message());
+        }
+
+        if (threads == 0)
+            threads = max(1u, thread::hardware_concurrency());
+        threads = static_cast<unsigned>(min<size_t>(threads, students_.size() / kExportBlock + 1));
+
+        FileSlots slots(maxOpenFiles);
+        atomic<size_t> next{0};
+        atomic<size_t> written{0};
+        atomic<uintmax_t> bytes{0};
+        mutex failuresMutex;
+
+        auto worker = [&]()
+        {
+            string buf; // reused for every card this worker renders
+            vector<pair<string, string>> failures;
+            size_t myWritten = 0;
+            uintmax_t myBytes = 0;
+            for (;;)
+            {
+                size_t begin = next.fetch_add(kExportBlock);
+                if (begin >= students_.size())
+                    break;
+                size_t end = min(begin + kExportBlock, students_.size());
+                for (size_t i = begin; i < end; ++i)
+                {
+                    buf.clear();
+                    students_[i].appendReportCard(buf);
+                    string path = classDirs[table_.classIds()[i]] + "/" + to_string(students_[i].getRoll()) + ".txt";
+
+                    slots.acquire();
+                    ofstream ofs(path, ios::binary | ios::trunc);
+                    bool ok = ofs.is_open();
+                    if (ok)
+                    {
+                        ofs.write(buf.data(), static_cast<streamsize>(buf.size()));
+                        ofs.close();
+                        ok = static_cast<bool>(ofs);
+                    }
+                    slots.release();
+
+                    if (ok)
+                    {
+                        ++myWritten;
+                        myBytes += buf.size();
+                    }
+                    else
+                    {
+                        failures.emplace_back(path, ofs.is_open() ? "write failed" : "cannot open file");
+                    }
+                }
+            }
+            written += myWritten;
+            bytes += myBytes;
+            if (!failures.empty())
+            {
+                lock_guard<mutex> lock(failuresMutex);
+                result.failures.insert(result.failures.end(), failures.begin(), failures.end());
+            }
+        };
+
+        vector<thread> pool;
+        for (unsigned t = 1; t < threads; ++t)
+            pool.emplace_back(worker);
+        worker(); // the calling thread works too
+        for (auto &t : pool)
+            t.join();
+
+        result.written = written;
+        result.bytes = bytes;
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        return result;
+    }
+
+    const StudentTable &StudentManager::getTable() const
+    {
+        return table_;
     }
 
     void StudentManager::sortByPercentageDesc()
     {
-        sort(students_.begin(), students_.end(), [](const Student &a, const Student &b)
-             { return a.getPercentage() > b.getPercentage(); });
-        saveToFile();
+        Metrics::Timer timer(MetricOp::Sort);
+        auto store = lockStore();
+        reorderByPercentage();
+        persist("S");
+    }
+
+    void StudentManager::reorderByPercentage()
+    {
+        // sort small keys, then move each student exactly once (journal replay relies on the
+        // order being deterministic)
+        RankingResult ranked = rankRows(table_);
+        vector<Student> sorted;
+        sorted.reserve(students_.size());
+        for (uint32_t row : ranked.order)
+            sorted.push_back(move(students_[row]));
+        students_.swap(sorted);
+        rebuildIndex();
     }
 
     bool StudentManager::loadFromFile()
     {
+        Metrics::Timer timer(MetricOp::Load);
+        auto store = lockStore();
+        ++storeEpoch_;
         students_.clear();
-        ifstream ifs(filename_);
-        if (!ifs.is_open())
+        arenas_.clear(); // every record of the previous load is gone; free its slabs at once
+        keyIndex_.clear();
+        rollIndex_.clear();
+        table_.clear();
+        journalRecords_ = 0;
+
+        uint64_t csvSize = 0, csvMtime = 0;
+        if (loadMirroredSnapshot(csvSize, csvMtime))
+        {
+            rebuildIndex();
+            replayJournal(csvSize, csvMtime);
+            Metrics::add(MetricCounter::RecordsLoaded, students_.size());
+            return true;
+        }
+
+        MappedFile file(filename_);
+        if (!file.isOpen())
         {
             // file not present is normal; treat as empty dataset
+            replayJournal(0, 0);
+            Metrics::add(MetricCounter::RecordsLoaded, students_.size());
             return true;
         }
-        string line;
-        while (getline(ifs, line))
+        unsigned threads = loadThreads_ ? loadThreads_ : max(1u, thread::hardware_concurrency());
+        size_t failures;
+        if (threads > 1 && file.size() >= kMinParallelLoadBytes)
         {
-            if (line.empty())
-                continue;
-            Student s;
-            if (Student::fromCSV(line, s))
-            {
-                students_.push_back(s);
-            }
-            else
-            {
-                // skip bad lines but continue
-            }
+            failures = parseLinesParallel(file.view(), threads, students_, arenaStorage_ ? &arenas_ : nullptr);
         }
-        ifs.close();
+        else
+        {
+            students_.reserve(count(file.data(), file.data() + file.size(), '\n') + 1);
+            failures = parseLines(file.view(), students_, loadResource());
+        }
+        rebuildIndex();
+        Metrics::add(MetricCounter::BytesRead, file.size());
+        Metrics::add(MetricCounter::ParseFailures, failures);
+
+        if (!fileIdentity(filename_, csvSize, csvMtime))
+            csvSize = csvMtime = 0;
+        replayJournal(csvSize, csvMtime);
+        Metrics::add(MetricCounter::RecordsLoaded, students_.size());
         return true;
     }
 
     bool StudentManager::saveToFile() const
     {
+        Metrics::Timer timer(MetricOp::Save);
+        lock_guard<mutex> files(fileMutex_); // never interleave with a write-behind pass
         string tmp = filename_ + ".tmp";
-        ofstream ofs(tmp, ios::trunc);
+        // binary: lines end in a bare '\n' on every platform, matching the byte-level readers
+        ofstream ofs(tmp, ios::binary | ios::trunc);
         if (!ofs.is_open())
             return false;
+        // serialize into one reused buffer and hand it to the stream in large blocks
+        string buf;
+        buf.reserve(kSaveFlushBytes + 4096);
+        size_t written = 0;
+        vector<IndexEntry> index;
+        if (diskIndex_)
+            index.reserve(students_.size());
         for (const auto &s : students_)
         {
-            ofs << s.toCSV() << "\n";
+            size_t start = buf.size();
+            s.appendCSV(buf);
+            if (diskIndex_)
+                index.push_back(IndexEntry{s.getClassId(), s.getRoll(), written + start,
+                                           static_cast<uint32_t>(buf.size() - start)});
+            buf.push_back('\n');
+            if (buf.size() >= kSaveFlushBytes)
+            {
+                ofs.write(buf.data(), static_cast<streamsize>(buf.size()));
+                written += buf.size();
+                buf.clear();
+            }
         }
+        ofs.write(buf.data(), static_cast<streamsize>(buf.size()));
+        written += buf.size();
         ofs.close();
+        if (!ofs)
+            return false; // keep the old file rather than rename a partial one
+        Metrics::add(MetricCounter::BytesWritten, written);
         // rename temp to actual (atomic on most OSes)
-        if (std::rename(tmp.c_str(), filename_.c_str()) != 0)
+        if (!replaceWithTemp(tmp, filename_))
+            return false;
+        // the snapshot now contains every journaled change
+        std::remove(journalPath().c_str());
         {
-            // attempt fallback: remove original and rename again
-            std::remove(filename_.c_str());
-            if (std::rename(tmp.c_str(), filename_.c_str()) != 0)
-                return false;
+            auto store = lockStore();
+            journalRecords_ = 0;
+            ++storeEpoch_; // a background pass encoded before this save must not land after it
+        }
+
+        uint64_t csvSize, csvMtime;
+        if (mirrorSnapshot_ && fileIdentity(filename_, csvSize, csvMtime))
+        {
+            // a stale mirror is ignored on load, so failing here only costs start-up time
+            writeSnapshotFile(snapshotPath(), students_, csvSize, csvMtime);
         }
+        // offsets were collected while writing, so the index never re-reads the CSV; a stale
+        // index is likewise ignored by DiskIndex
+        if (diskIndex_)
+            DiskIndex::write(filename_, index);
         return true;
     }
 
-    bool StudentManager::rollExists(int roll) const
+    bool StudentManager::saveSnapshot(const string &path) const
     {
-        for (const auto &s : students_)
+        // 0/0 identity: a standalone snapshot never stands in for the CSV on load
+        return writeSnapshotFile(path, students_, 0, 0);
+    }
+
+    bool StudentManager::loadSnapshot(const string &path)
+    {
+        uint64_t csvSize, csvMtime;
+        vector<Student> loaded;
+        if (!readSnapshotFile(path, csvSize, csvMtime, loaded))
+            return false;
+        {
+            auto store = lockStore();
+            students_.swap(loaded);
+            rebuildIndex();
+        }
+        if (asyncPersistence_)
+        {
+            markDirty(students_.size());
+            return true;
+        }
+        return checkpoint();
+    }
+
+    void StudentManager::setSnapshotMirroring(bool enabled)
+    {
+        auto store = lockStore();
+        mirrorSnapshot_ = enabled;
+    }
+
+    void StudentManager::setDiskIndex(bool enabled)
+    {
+        auto store = lockStore();
+        diskIndex_ = enabled;
+    }
+
+    string StudentManager::snapshotPath() const
+    {
+        return filename_ + ".snap";
+    }
+
+    bool StudentManager::loadMirroredSnapshot(uint64_t &csvSize, uint64_t &csvMtime)
+    {
+        uint64_t size, mtime, snapSize, snapMtime;
+        if (!fileIdentity(filename_, size, mtime))
+            return false;
+        vector<Student> loaded;
+        if (!readSnapshotFile(snapshotPath(), snapSize, snapMtime, loaded, loadResource()) ||
+            snapSize != size || snapMtime != mtime)
+        {
+            loaded.clear();
+            arenas_.clear(); // only this attempt's arena exists yet; the CSV load starts afresh
+            return false;
+        }
+        students_.swap(loaded);
+        csvSize = size;
+        csvMtime = mtime;
+        return true;
+    }
+
+    void StudentManager::setJournaling(bool enabled)
+    {
+        if (journaling_ && !enabled)
+        {
+            checkpoint();
+            {
+                auto store = lockStore(); // the writer reads the mode
+                journaling_ = false;
+            }
+            if (!asyncPersistence_)
+                stopWriter();
+            return;
+        }
+        if (enabled)
         {
-            if (s.getRoll() == roll)
+            {
+                auto store = lockStore();
+                journaling_ = true;
+            }
+            startWriter(); // compaction runs on the background writer
+        }
+    }
+
+    void StudentManager::setLoadThreads(unsigned threads)
+    {
+        loadThreads_ = threads;
+    }
+
+    unsigned StudentManager::getLoadThreads() const
+    {
+        return loadThreads_;
+    }
+
+    void StudentManager::setArenaStorage(bool enabled)
+    {
+        arenaStorage_ = enabled;
+    }
+
+    bool StudentManager::getArenaStorage() const
+    {
+        return arenaStorage_;
+    }
+
+    pmr::memory_resource *StudentManager::loadResource()
+    {
+        if (!arenaStorage_)
+            return pmr::get_default_resource();
+        arenas_.push_back(make_unique<pmr::monotonic_buffer_resource>(kArenaSlabBytes));
+        return arenas_.back().get();
+    }
+
+    bool StudentManager::isJournaling() const
+    {
+        return journaling_;
+    }
+
+    bool StudentManager::checkpoint()
+    {
+        if (!writer_.joinable())
+            return saveToFile();
+        // hand the pass to the writer, which owns the CSV while it runs, and wait for it
+        unique_lock<mutex> lock(asyncMutex_);
+        checkpointDue_ = true;
+        uint64_t target = ++changeSeq_;
+        ++flushWaiters_;
+        asyncCv_.notify_all();
+        asyncCv_.wait(lock, [&]
+                      { return attemptedSeq_ >= target; });
+        --flushWaiters_;
+        return writtenSeq_ >= target;
+    }
+
+    StudentManager::~StudentManager()
+    {
+        stopWriter();
+    }
+
+    void StudentManager::setAsyncPersistence(bool enabled, chrono::milliseconds delay, size_t maxPendingChanges)
+    {
+        if (!enabled)
+        {
+            flush();
+            {
+                auto store = lockStore();
+                asyncPersistence_ = false;
+            }
+            if (!journaling_)
+                stopWriter();
+            return;
+        }
+        {
+            lock_guard<mutex> lock(asyncMutex_);
+            asyncDelay_ = delay;
+            asyncMaxPending_ = max<size_t>(1, maxPendingChanges);
+        }
+        {
+            auto store = lockStore();
+            asyncPersistence_ = true;
+        }
+        startWriter();
+    }
+
+    bool StudentManager::isAsyncPersistence() const
+    {
+        return asyncPersistence_;
+    }
+
+    bool StudentManager::flush()
+    {
+        if (!asyncPersistence_)
+            return true; // synchronous and journaled changes are on disk when each call returns
+        unique_lock<mutex> lock(asyncMutex_);
+        uint64_t target = changeSeq_;
+        if (writtenSeq_ >= target)
+            return true;
+        ++flushWaiters_;
+        asyncCv_.notify_all();
+        asyncCv_.wait(lock, [&]
+                      { return attemptedSeq_ >= target; });
+        --flushWaiters_;
+        return writtenSeq_ >= target;
+    }
+
+    void StudentManager::startWriter()
+    {
+        if (writer_.joinable())
+            return;
+        {
+            lock_guard<mutex> lock(asyncMutex_);
+            stopWriter_ = false;
+        }
+        writer_ = thread(&StudentManager::writeBehindLoop, this);
+    }
+
+    bool StudentManager::stopWriter()
+    {
+        if (!writer_.joinable())
+            return true;
+        bool ok = flush();
+        {
+            lock_guard<mutex> lock(asyncMutex_);
+            stopWriter_ = true;
+        }
+        asyncCv_.notify_all();
+        writer_.join();
+        // last resort: one synchronous attempt so a failed write-behind does not lose changes
+        return ok || saveToFile();
+    }
+
+    void StudentManager::markDirty(size_t changes)
+    {
+        {
+            lock_guard<mutex> lock(asyncMutex_);
+            if (pendingChanges_ == 0)
+                firstPending_ = chrono::steady_clock::now();
+            pendingChanges_ += changes;
+            ++changeSeq_;
+        }
+        asyncCv_.notify_all();
+    }
+
+    void StudentManager::writeBehindLoop()
+    {
+        unique_lock<mutex> lock(asyncMutex_);
+        for (;;)
+        {
+            asyncCv_.wait(lock, [&]
+                          { return stopWriter_ || pendingChanges_ > 0 || checkpointDue_; });
+            if (pendingChanges_ == 0 && !checkpointDue_)
+                return; // stopping with nothing left to write
+
+            // coalesce: keep collecting until the delay is up, enough changes piled up, or a
+            // caller is waiting in flush(); a due checkpoint starts at once
+            asyncCv_.wait_until(lock, firstPending_ + asyncDelay_, [&]
+                                { return stopWriter_ || flushWaiters_ > 0 || checkpointDue_ ||
+                                         pendingChanges_ >= asyncMaxPending_; });
+            uint64_t seq = changeSeq_; // everything up to here is in memory and will be encoded
+            pendingChanges_ = 0;
+            checkpointDue_ = false;
+
+            lock.unlock();
+            bool ok = writeBehind();
+            {
+                lock_guard<mutex> store(storeMutex_);
+                compactionQueued_ = false; // the journal is short again, or the pass needs a retry
+            }
+            lock.lock();
+
+            attemptedSeq_ = seq;
+            if (ok)
+            {
+                writtenSeq_ = seq;
+            }
+            else if (pendingChanges_ == 0)
+            {
+                pendingChanges_ = 1; // retry after another delay
+                firstPending_ = chrono::steady_clock::now();
+            }
+            asyncCv_.notify_all();
+            if (!ok && stopWriter_)
+                return; // stopWriter() falls back to a synchronous save
+        }
+    }
+
+    bool StudentManager::writeBehind()
+    {
+        Metrics::Timer timer(MetricOp::Save);
+        // encode under the store lock (CPU only), then do the disk I/O without it
+        string csv, snapshot;
+        vector<IndexEntry> index;
+        bool mirror, indexed;
+        size_t cut;          // journal records the encode started from
+        uint64_t cutOffset;  // and the journal's size then (appends are whole under the lock)
+        uint64_t epoch;      // storeEpoch_ the encode saw
+        for (unsigned attempt = 0;; ++attempt)
+        {
+            unique_lock<mutex> store(storeMutex_);
+            cut = journalRecords_;
+            error_code ec;
+            cutOffset = cut == 0 ? 0 : filesystem::file_size(journalPath(), ec);
+            epoch = storeEpoch_;
+            uint64_t rows = rowsVersion_;
+            indexed = diskIndex_;
+            mirror = mirrorSnapshot_;
+            csv.clear();
+            snapshot.clear();
+            index.clear();
+            if (mirror)
+                beginSnapshot(students_.size(), 0, 0, snapshot);
+            // When every change is journaled, the lock is dropped between slices so mutators
+            // never wait for a whole encode. A marks or comment edit that lands in between may
+            // or may not show in the encoded rows, but its journal record comes after the cut
+            // and sets the same value again on replay. Added, removed or reordered rows would
+            // shift the slices, so those start the encode over.
+            size_t slice = journaling_ && attempt < kMaxEncodeRestarts ? kEncodeSliceRows : students_.size();
+            size_t i = 0;
+            while (i < students_.size())
+            {
+                for (size_t end = min(students_.size(), i + slice); i < end; ++i)
+                {
+                    const Student &s = students_[i];
+                    size_t start = csv.size();
+                    s.appendCSV(csv);
+                    if (indexed)
+                        index.push_back(IndexEntry{s.getClassId(), s.getRoll(), start,
+                                                   static_cast<uint32_t>(csv.size() - start)});
+                    csv.push_back('\n');
+                    if (mirror)
+                        s.appendBinary(snapshot);
+                }
+                if (i == students_.size())
+                    break;
+                store.unlock();
+                this_thread::yield();
+                store.lock();
+                if (rowsVersion_ != rows || storeEpoch_ != epoch)
+                    break;
+            }
+            if (i == students_.size())
+                break;
+        }
+        if (mirror)
+            putU64(snapshot, 0); // checksum slot, filled in by stampSnapshot()
+
+        lock_guard<mutex> files(fileMutex_);
+        string tmp = filename_ + ".tmp";
+        uint64_t csvSize, csvMtime; // rename keeps both, so the temp file's identity is final
+        if (!writeFile(tmp, csv, ios::binary) || !fileIdentity(tmp, csvSize, csvMtime))
+            return false;
+        {
+            // mutators append to the journal under this lock, so nothing lands while it moves
+            lock_guard<mutex> store(storeMutex_);
+            if (epoch != storeEpoch_)
+            {
+                std::remove(tmp.c_str()); // a reload or full save already replaced this state
                 return true;
+            }
+            if (journalRecords_ == cut)
+            {
+                if (!replaceWithTemp(tmp, filename_))
+                    return false;
+                std::remove(journalPath().c_str()); // every record is in the new CSV
+            }
+            else
+            {
+                // records appended since the encode move to a journal based on the new CSV.
+                // It is complete before the CSV is swapped in; replayJournal() picks up the
+                // ".next" file if a crash comes between the two renames.
+                string tail, next = journalPath() + ".next";
+                if (!journalTail(journalPath(), cutOffset, tail) ||
+                    !writeFile(next, journalHeader(csvSize, csvMtime) + "\n" + tail, ios::binary) ||
+                    !replaceWithTemp(tmp, filename_) || !replaceWithTemp(next, journalPath()))
+                    return false;
+            }
+            journalRecords_ -= cut;
+        }
+        if (mirror)
+        {
+            stampSnapshot(snapshot, csvSize, csvMtime);
+            writeFileReplacing(snapshotPath(), snapshot, ios::binary);
+        }
+        if (indexed)
+            DiskIndex::write(filename_, index);
+        return true;
+    }
+
+    unique_lock<mutex> StudentManager::lockStore() const
+    {
+        // only the write-behind thread reads students_ concurrently; without it nothing to guard
+        return writer_.joinable() ? unique_lock<mutex>(storeMutex_) : unique_lock<mutex>();
+    }
+
+    string StudentManager::journalPath() const
+    {
+        return filename_ + ".journal";
+    }
+
+    bool StudentManager::persist(const string &record)
+    {
+        return persistRecords(vector<string>{record});
+    }
+
+    bool StudentManager::persistRecords(const vector<string> &records)
+    {
+        if (!journaling_)
+        {
+            if (!asyncPersistence_)
+                return saveToFile();
+            markDirty(records.size());
+            return true;
+        }
+
+        Metrics::Timer timer(MetricOp::JournalAppend);
+        // several records are framed as one group so replay applies all of them or none
+        string text;
+        if (records.size() > 1)
+            text += "B," + to_string(records.size()) + "\n";
+        for (const auto &r : records)
+        {
+            text += r;
+            text += "\n";
+        }
+
+        ofstream ofs(journalPath(), journalRecords_ == 0 ? ios::trunc : ios::app);
+        if (!ofs.is_open())
+            return false;
+        if (journalRecords_ == 0)
+        {
+            // tie the journal to the CSV it applies on top of (0/0 while there is none)
+            uint64_t baseSize, baseMtime;
+            if (!fileIdentity(filename_, baseSize, baseMtime))
+                baseSize = baseMtime = 0;
+            ofs << journalHeader(baseSize, baseMtime) << "\n";
+        }
+        ofs.write(text.data(), static_cast<streamsize>(text.size()));
+        ofs.flush();
+        if (!ofs)
+            return false;
+        ofs.close();
+        Metrics::add(MetricCounter::BytesWritten, text.size());
+        journalRecords_ += records.size();
+        // the change is durable now; a write-behind pass folds it into the CSV later
+        if (asyncPersistence_)
+            markDirty(records.size());
+
+        // compact once the journal is as large as the data set, on the writer thread so this
+        // call stays O(1); a failed pass loses nothing since the records are in the journal
+        if (journalRecords_ >= max(kMinCheckpointRecords, students_.size()) && !compactionQueued_)
+        {
+            compactionQueued_ = true;
+            {
+                lock_guard<mutex> lock(asyncMutex_);
+                checkpointDue_ = true;
+            }
+            asyncCv_.notify_all();
+        }
+        return true;
+    }
+
+    void StudentManager::replayJournal(uint64_t baseSize, uint64_t baseMtime)
+    {
+        // a background checkpoint that crashed between swapping in the CSV and its rebased
+        // journal left that journal as ".next"; anything else there never became live
+        string next = journalPath() + ".next";
+        {
+            ifstream pending(next);
+            string header;
+            bool live = pending.is_open() && getline(pending, header) && header == journalHeader(baseSize, baseMtime);
+            pending.close();
+            if (live)
+                replaceWithTemp(next, journalPath());
+            else
+                std::remove(next.c_str());
+        }
+
+        ifstream ifs(journalPath());
+        if (!ifs.is_open())
+            return;
+
+        string line;
+        if (!getline(ifs, line) || line != journalHeader(baseSize, baseMtime))
+        {
+            // journal belongs to another CSV (or is corrupt): its changes are already in the
+            // CSV or can no longer be applied safely
+            ifs.close();
+            std::remove(journalPath().c_str());
+            return;
+        }
+
+        // a line without newline (or a group missing records) is a torn write from a crash
+        auto readComplete = [&ifs](string &out)
+        { return getline(ifs, out) && !ifs.eof(); };
+
+        streamoff good = ifs.tellg();
+        bool torn = false;
+        while (!torn && getline(ifs, line))
+        {
+            if (ifs.eof())
+            {
+                torn = true;
+                break;
+            }
+            if (line.compare(0, 2, "B,") == 0)
+            {
+                // the count is not trusted for sizing: records are read one at a time, and a
+                // count that does not parse is treated like a torn line
+                size_t count = 0;
+                const char *first = line.data() + 2, *last = line.data() + line.size();
+                auto parsed = from_chars(first, last, count);
+                if (parsed.ec != errc() || parsed.ptr != last || first == last)
+                {
+                    torn = true;
+                    break;
+                }
+                vector<string> group;
+                string record;
+                while (group.size() < count)
+                {
+                    if (!readComplete(record))
+                    {
+                        torn = true;
+                        break;
+                    }
+                    group.push_back(move(record));
+                }
+                if (torn)
+                    break;
+                for (const auto &record : group)
+                    applyJournalRecord(record);
+                journalRecords_ += count;
+            }
+            else if (!line.empty())
+            {
+                applyJournalRecord(line);
+                ++journalRecords_;
+            }
+            good = ifs.tellg();
+        }
+        ifs.close();
+
+        // cut the torn tail off so later appends start on a clean line
+        if (torn)
+        {
+            error_code ec;
+            filesystem::resize_file(journalPath(), static_cast<uintmax_t>(good), ec);
+        }
+    }
+
+    bool StudentManager::applyJournalRecord(const string &record)
+    {
+        if (record == "S")
+        {
+            reorderByPercentage();
+            return true;
+        }
+        if (record.size() < 2 || record[1] != ',')
+            return false;
+
+        try
+        {
+            string payload = record.substr(2);
+            if (record[0] == 'A')
+            {
+                Student s;
+                return Student::fromCSV(payload, s) && insertStudent(s);
+            }
+
+            size_t comma = payload.find(',');
+            int roll = stoi(payload.substr(0, comma));
+            string rest = comma == string::npos ? "" : payload.substr(comma + 1);
+
+            if (record[0] == 'D')
+                return eraseRoll(roll);
+            if (record[0] == 'C')
+                return replaceComment(roll, rest);
+            if (record[0] == 'M')
+            {
+                vector<int> marks;
+                stringstream sm(rest);
+                string token;
+                while (getline(sm, token, ';'))
+                    marks.push_back(stoi(token));
+                return replaceMarks(roll, marks);
+            }
+        }
+        catch (...)
+        {
+            // malformed record; skip it
         }
         return false;
     }
 
-    std::vector<Student> StudentManager::getStudentsByClass(const std::string &className) const
-    {   // Initialize vector to store matching students
-        std::vector<Student> result;
+    bool StudentManager::rollExists(int roll) const
+    {
+        return rollIndex_.find(roll) != rollIndex_.end();
+    }
 
-        for (const auto &s : students_)
-        {  // Check if the student's class name matches the input class name
-            if (s.getClassName() == className)
-              // Add matching student to the result vector
-                result.push_back(s);
+    bool StudentManager::rollExistsInClass(const string &className, int roll) const
+    {
+        uint32_t classId;
+        if (!ClassNames::find(className, classId))
+            return false;
+        return keyIndex_.find(ClassRollKey{classId, roll}) != keyIndex_.end();
+    }
+
+    size_t StudentManager::ClassRollHash::operator()(const ClassRollKey &key) const
+    {
+        size_t h = hash<uint32_t>()(key.classId);
+        // boost-style hash_combine
+        h ^= hash<int>()(key.roll) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    void StudentManager::rebuildIndex()
+    {
+        ++rowsVersion_; // positions may have changed
+        keyIndex_.clear();
+        rollIndex_.clear();
+        keyIndex_.reserve(students_.size());
+        for (size_t i = 0; i < students_.size(); ++i)
+        {
+            const Student &s = students_[i];
+            // first occurrence wins, matching the old linear scans
+            keyIndex_.emplace(ClassRollKey{s.getClassId(), s.getRoll()}, i);
+            rollIndex_[s.getRoll()].push_back(i);
         }
+        table_.rebuild(students_);
+    }
 
-        return result;
+    std::vector<Student> StudentManager::getStudentsByClass(const std::string &className) const
+    {   // Copy the class members listed by the class index
+        StudentRange members = getClassView(className);
+        return std::vector<Student>(members.begin(), members.end());
+    }
+
+    StudentRange StudentManager::getClassView(const string &className) const
+    {
+        Metrics::Timer timer(MetricOp::ClassQuery);
+        uint32_t classId;
+        if (!table_.findClass(className, classId))
+            return StudentRange();
+        return StudentRange(students_, table_.rowsOfClass(classId));
+    }
+
+    const ClassSummary &StudentManager::getClassSummary(const string &className) const
+    {
+        static const ClassSummary empty;
+        uint32_t classId;
+        if (!table_.findClass(className, classId))
+            return empty;
+        return table_.summary(classId);
+    }
+
+    const ClassSummary &StudentManager::getSchoolSummary() const
+    {
+        return table_.summary();
+    }
+
+    vector<string> StudentManager::getClassNames() const
+    {
+        vector<string> names;
+        for (uint32_t id = 0; id < table_.classCount(); ++id)
+            if (!table_.rowsOfClass(id).empty())
+                names.push_back(table_.className(id));
+        sort(names.begin(), names.end());
+        return names;
     }
 
 } // namespace ReportCard
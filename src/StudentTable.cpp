@@ -0,0 +1,380 @@
+#include "StudentTable.h"
+#include "GradeKernel.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace ReportCard
+{
+
+    void StudentTable::clear()
+    {
+        rolls_.clear();
+        classIds_.clear();
+        totals_.clear();
+        percentages_.clear();
+        grades_.clear();
+        pass_.clear();
+        marks_.clear();
+        markOffsets_.assign(1, 0);
+        for (auto &rows : classRows_)
+            rows.clear();
+        topRow_ = -1;
+        for (auto &summary : classSummaries_)
+            summary = ClassSummary();
+        school_ = ClassSummary();
+    }
+
+    void StudentTable::rebuild(const vector<Student> &students)
+    {
+        clear();
+        rolls_.reserve(students.size());
+        classIds_.reserve(students.size());
+        totals_.reserve(students.size());
+        percentages_.reserve(students.size());
+        grades_.reserve(students.size());
+        pass_.reserve(students.size());
+        markOffsets_.reserve(students.size() + 1);
+        for (const auto &s : students)
+            append(s);
+    }
+
+    void StudentTable::append(const Student &s)
+    {
+        uint32_t classId = s.getClassId();
+        rowsFor(classId).push_back(rolls_.size());
+        rolls_.push_back(s.getRoll());
+        classIds_.push_back(classId);
+        totals_.push_back(s.getTotal());
+        percentages_.push_back(s.getPercentage());
+        grades_.push_back(s.getGradeCode());
+        pass_.push_back(s.isPass() ? 1 : 0);
+        MarkSpan marks = s.getMarks();
+        marks_.insert(marks_.end(), marks.begin(), marks.end());
+        markOffsets_.push_back(marks_.size());
+
+        size_t row = rolls_.size() - 1;
+        if (topRow_ < 0 || percentages_[row] > percentages_[topRow_])
+            topRow_ = static_cast<ptrdiff_t>(row);
+        admit(row);
+    }
+
+    void StudentTable::update(size_t row, const Student &s)
+    {
+        double before = percentages_[row];
+        uint32_t oldClass = classIds_[row];
+        retire(row);
+
+        uint32_t classId = s.getClassId();
+        if (classId != classIds_[row])
+        {
+            // move the row between class lists, keeping both in ascending row order
+            vector<size_t> &to = rowsFor(classId);
+            vector<size_t> &from = classRows_[classIds_[row]];
+            from.erase(lower_bound(from.begin(), from.end(), row));
+            to.insert(lower_bound(to.begin(), to.end(), row), row);
+            classIds_[row] = classId;
+        }
+        rolls_[row] = s.getRoll();
+        setComputed(row, s);
+
+        MarkSpan m = s.getMarks();
+        size_t begin = markOffsets_[row];
+        size_t oldCount = markOffsets_[row + 1] - begin;
+        if (m.size() != oldCount)
+        {
+            // subject count changed: resize this row's slice and shift the later offsets
+            if (m.size() > oldCount)
+                marks_.insert(marks_.begin() + begin + oldCount, m.size() - oldCount, 0);
+            else
+                marks_.erase(marks_.begin() + begin + m.size(), marks_.begin() + begin + oldCount);
+            ptrdiff_t delta = static_cast<ptrdiff_t>(m.size()) - static_cast<ptrdiff_t>(oldCount);
+            for (size_t i = row + 1; i < markOffsets_.size(); ++i)
+                markOffsets_[i] += delta;
+        }
+        copy(m.begin(), m.end(), marks_.begin() + begin);
+
+        admit(row);
+        settle(row, oldClass, before);
+    }
+
+    void StudentTable::updateMark(size_t row, size_t subject, const Student &s)
+    {
+        double before = percentages_[row];
+        retire(row);
+        marks_[markOffsets_[row] + subject] = s.getMarks()[subject];
+        setComputed(row, s);
+        admit(row);
+        settle(row, classIds_[row], before);
+    }
+
+    void StudentTable::setComputed(size_t row, const Student &s)
+    {
+        totals_[row] = s.getTotal();
+        percentages_[row] = s.getPercentage();
+        grades_[row] = s.getGradeCode();
+        pass_[row] = s.isPass() ? 1 : 0;
+    }
+
+    // Add (sign 1) or take away (sign -1) one row's share of a summary; min/max are not touched.
+    void StudentTable::accumulate(ClassSummary &summary, size_t row, int sign) const
+    {
+        summary.count += sign;
+        summary.percentageSum += sign * percentages_[row];
+        summary.passCount += sign * pass_[row];
+        summary.gradeCounts[static_cast<int>(grades_[row])] += sign;
+        size_t begin = markOffsets_[row], subjects = markOffsets_[row + 1] - begin;
+        if (summary.subjectSums.size() < subjects)
+        {
+            summary.subjectSums.resize(subjects, 0);
+            summary.subjectCounts.resize(subjects, 0);
+        }
+        for (size_t j = 0; j < subjects; ++j)
+        {
+            summary.subjectSums[j] += sign * marks_[begin + j];
+            summary.subjectCounts[j] += sign;
+        }
+        if (summary.count == 0)
+            summary = ClassSummary(); // drop accumulated rounding along with the last row
+    }
+
+    void StudentTable::admit(size_t row)
+    {
+        uint32_t classId = classIds_[row];
+        if (classId >= classSummaries_.size())
+            classSummaries_.resize(classId + 1);
+        double p = percentages_[row];
+        for (ClassSummary *summary : {&classSummaries_[classId], &school_})
+        {
+            accumulate(*summary, row, 1);
+            if (summary->count == 1)
+            {
+                summary->minPercentage = summary->maxPercentage = p;
+            }
+            else
+            {
+                summary->minPercentage = min(summary->minPercentage, p);
+                summary->maxPercentage = max(summary->maxPercentage, p);
+            }
+        }
+    }
+
+    void StudentTable::retire(size_t row)
+    {
+        accumulate(classSummaries_[classIds_[row]], row, -1);
+        accumulate(school_, row, -1);
+    }
+
+    void StudentTable::settle(size_t row, uint32_t oldClass, double before)
+    {
+        // keep the cached topper from the change alone; only a topper that dropped needs a scan
+        double after = percentages_[row];
+        ptrdiff_t r = static_cast<ptrdiff_t>(row);
+        if (r == topRow_)
+        {
+            if (after < before)
+                topRow_ = scanTopper();
+        }
+        else if (after > percentages_[topRow_] || (after == percentages_[topRow_] && r < topRow_))
+        {
+            topRow_ = r;
+        }
+
+        // min/max only need a rescan when the row that held one moved inwards (or left)
+        uint32_t classId = classIds_[row];
+        auto stale = [&](const ClassSummary &summary, bool left)
+        {
+            return summary.count > 0 &&
+                   ((before == summary.maxPercentage && (left || after < before)) ||
+                    (before == summary.minPercentage && (left || after > before)));
+        };
+        if (stale(classSummaries_[oldClass], oldClass != classId))
+            rescanExtremes(oldClass);
+        if (stale(school_, false))
+            rescanExtremes(kAllClasses);
+    }
+
+    void StudentTable::rescanExtremes(uint32_t classId)
+    {
+        ClassSummary &summary = classId == kAllClasses ? school_ : classSummaries_[classId];
+        bool first = true;
+        forEachRow(classId, [&](size_t i)
+                   {
+            double p = percentages_[i];
+            summary.minPercentage = first ? p : min(summary.minPercentage, p);
+            summary.maxPercentage = first ? p : max(summary.maxPercentage, p);
+            first = false; });
+    }
+
+    ptrdiff_t StudentTable::scanTopper() const
+    {
+        ptrdiff_t best = -1;
+        for (size_t i = 0; i < percentages_.size(); ++i)
+            if (best < 0 || percentages_[i] > percentages_[best])
+                best = static_cast<ptrdiff_t>(i);
+        return best;
+    }
+
+    void StudentTable::regrade()
+    {
+        gradeRows(marks_.data(), markOffsets_.data(), size(), totals_.data(), percentages_.data(),
+                  grades_.data(), pass_.data());
+        topRow_ = scanTopper();
+        for (auto &summary : classSummaries_)
+            summary = ClassSummary();
+        school_ = ClassSummary();
+        for (size_t i = 0; i < size(); ++i)
+            admit(i);
+    }
+
+    size_t StudentTable::size() const { return rolls_.size(); }
+    const vector<int> &StudentTable::rolls() const { return rolls_; }
+    const vector<uint32_t> &StudentTable::classIds() const { return classIds_; }
+    const vector<int> &StudentTable::totals() const { return totals_; }
+    const vector<double> &StudentTable::percentages() const { return percentages_; }
+    const vector<Grade> &StudentTable::grades() const { return grades_; }
+    const vector<uint8_t> &StudentTable::passFlags() const { return pass_; }
+    const vector<int> &StudentTable::marks() const { return marks_; }
+    const vector<size_t> &StudentTable::markOffsets() const { return markOffsets_; }
+
+    vector<size_t> &StudentTable::rowsFor(uint32_t classId)
+    {
+        if (classId >= classRows_.size())
+            classRows_.resize(classId + 1);
+        return classRows_[classId];
+    }
+
+    bool StudentTable::findClass(string_view className, uint32_t &outId) const
+    {
+        return ClassNames::find(className, outId);
+    }
+
+    const string &StudentTable::className(uint32_t classId) const { return ClassNames::byId(classId).text; }
+    size_t StudentTable::classCount() const { return classRows_.size(); }
+
+    ptrdiff_t StudentTable::topperRow(uint32_t classId) const
+    {
+        if (classId == kAllClasses)
+            return topRow_;
+        ptrdiff_t best = -1;
+        forEachRow(classId, [&](size_t i)
+                   {
+            if (best < 0 || percentages_[i] > percentages_[best])
+                best = static_cast<ptrdiff_t>(i); });
+        return best;
+    }
+
+    vector<size_t> StudentTable::topRows(size_t k, uint32_t classId) const
+    {
+        // "a ranks before b": higher percentage, then earlier row
+        auto before = [this](size_t a, size_t b)
+        {
+            if (percentages_[a] != percentages_[b])
+                return percentages_[a] > percentages_[b];
+            return a < b;
+        };
+
+        // heap top is the weakest of the k best rows seen so far
+        vector<size_t> heap;
+        heap.reserve(min(k, count(classId)));
+        if (k == 0)
+            return heap;
+        forEachRow(classId, [&](size_t i)
+                   {
+            if (heap.size() < k)
+            {
+                heap.push_back(i);
+                push_heap(heap.begin(), heap.end(), before);
+            }
+            else if (before(i, heap.front()))
+            {
+                pop_heap(heap.begin(), heap.end(), before);
+                heap.back() = i;
+                push_heap(heap.begin(), heap.end(), before);
+            } });
+        sort_heap(heap.begin(), heap.end(), before);
+        return heap;
+    }
+
+    size_t StudentTable::countAbove(double percentage, uint32_t classId) const
+    {
+        size_t n = 0;
+        forEachRow(classId, [&](size_t i)
+                   { n += (percentages_[i] > percentage); });
+        return n;
+    }
+
+    size_t StudentTable::count(uint32_t classId) const
+    {
+        return classId == kAllClasses ? size() : rowsOfClass(classId).size();
+    }
+
+    double StudentTable::averagePercentage(uint32_t classId) const
+    {
+        return summary(classId).averagePercentage();
+    }
+
+    double StudentTable::passRate(uint32_t classId) const
+    {
+        return summary(classId).passRate();
+    }
+
+    array<size_t, kGradeCount> StudentTable::gradeHistogram(uint32_t classId) const
+    {
+        return summary(classId).gradeCounts;
+    }
+
+    const ClassSummary &StudentTable::summary(uint32_t classId) const
+    {
+        static const ClassSummary empty;
+        if (classId == kAllClasses)
+            return school_;
+        return classId < classSummaries_.size() ? classSummaries_[classId] : empty;
+    }
+
+    double ClassSummary::averagePercentage() const
+    {
+        return count ? percentageSum / count : 0.0;
+    }
+
+    double ClassSummary::passRate() const
+    {
+        return count ? static_cast<double>(passCount) / count : 0.0;
+    }
+
+    double ClassSummary::subjectAverage(size_t subject) const
+    {
+        if (subject >= subjectSums.size() || subjectCounts[subject] == 0)
+            return 0.0;
+        return static_cast<double>(subjectSums[subject]) / subjectCounts[subject];
+    }
+
+    void ClassSummary::add(const Student &s)
+    {
+        double p = s.getPercentage();
+        minPercentage = count == 0 ? p : min(minPercentage, p);
+        maxPercentage = count == 0 ? p : max(maxPercentage, p);
+        ++count;
+        percentageSum += p;
+        passCount += s.isPass();
+        gradeCounts[static_cast<int>(s.getGradeCode())] += 1;
+        MarkSpan marks = s.getMarks();
+        if (subjectSums.size() < marks.size())
+        {
+            subjectSums.resize(marks.size(), 0);
+            subjectCounts.resize(marks.size(), 0);
+        }
+        for (size_t j = 0; j < marks.size(); ++j)
+        {
+            subjectSums[j] += marks[j];
+            subjectCounts[j] += 1;
+        }
+    }
+
+    const vector<size_t> &StudentTable::rowsOfClass(uint32_t classId) const
+    {
+        static const vector<size_t> none;
+        return classId < classRows_.size() ? classRows_[classId] : none;
+    }
+
+} // namespace ReportCard